@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <random>
+#include <cstdint>
 
 // This header-only Random namespace implements a self-seeding Mersenne Twister
 // It can be included into as many code files as needed (The inline keyword avoids ODR violations)
@@ -24,9 +25,26 @@ namespace Random
 		return std::mt19937{ ss };
 	}
 
-	// Here's our global std::mt19937 object.
-	// The inline keyword means we only have one global instance for our whole program.
-	inline std::mt19937 mt{ generate() }; // generates a seeded std::mt19937 and copies it into our global object
+	// Here's our std::mt19937 object.
+	// The inline keyword means we only have one definition for our whole program, and thread_local
+	// gives every thread its own self-seeded engine, so parallel workers never share (and race on) one state.
+	inline thread_local std::mt19937 mt{ generate() }; // generates a seeded std::mt19937 and copies it into our thread's object
+
+	// Returns an independent engine for stream `id` of a given seed (e.g. one per population chunk)
+	inline std::mt19937 stream(std::uint64_t seed, std::uint64_t id)
+	{
+		std::seed_seq ss{
+			static_cast<std::seed_seq::result_type>(seed), static_cast<std::seed_seq::result_type>(seed >> 32),
+			static_cast<std::seed_seq::result_type>(id), static_cast<std::seed_seq::result_type>(id >> 32) };
+
+		return std::mt19937{ ss };
+	}
+
+	// Draws a 64 bit seed from the calling thread's engine
+	inline std::uint64_t seed()
+	{
+		return (static_cast<std::uint64_t>(mt()) << 32) | mt();
+	}
 
 	// Generate a random int between [min, max] (inclusive)
 	inline int get(int min, int max)
@@ -16,8 +16,6 @@ namespace Settings {
 
    namespace MultiThread {
       const int maxThreads{ omp_get_max_threads() };
-      constexpr int BASE_POPULATION_PARALLEL_THRESHOLD{ 500 };
-      const int POPULATION_PARALLEL_THRESHOLD{ BASE_POPULATION_PARALLEL_THRESHOLD * maxThreads / 4 };
    }
 
 }
@@ -56,12 +54,59 @@ inline void print_help()
    std::cout << "  initial_mutation_strength=1.0\n";
    std::cout << "  final_mutation_strength=0.2\n";
    std::cout << "  elite_fraction=0.02             --> percentage of individuals to keep in the next generation\n";
-   std::cout << "  target_function=mccormick       --> function to optimize\n";
+   std::cout << "  target_function=mccormick       --> function to optimize | available:  rastrigin  |  ackley  |  sphere  |  easom  |  mccormick  |  rosenbrock  |  schwefel  |  griewank  |  levy\n";
    std::cout << "  dimensions=2\n";
+   std::cout << "  transform=none                  --> (optional) CEC-style variant of the function | available:  none  |  shifted  |  rotated  |  shifted_rotated\n";
+   std::cout << "  transform_seed=1                --> (optional) seed of the shift vector and rotation matrix, independent of the run seed\n";
    std::cout << "  selection_method=tournament     --> available:  tournament  |  fps (fitness proportionate selection) |  ranking\n";
-   std::cout << "  points=2                        --> crossover methods | available:  one  |  two  |  uniform\n";
+   std::cout << "  tournament_size=3               --> (optional) candidates per tournament\n";
+   std::cout << "  points=2                        --> crossover methods | available:  one  |  two  |  uniform  |  arithmetic  |  blx  |  sbx\n";
+   std::cout << "  blx_alpha=0.5                   --> (optional) BLX-alpha interval extension\n";
+   std::cout << "  sbx_eta=15                      --> (optional) SBX distribution index, larger keeps children closer to the parents\n";
    std::cout << "  print_precision=4               --> number of digits to be displayed on terminal\n";
-   std::cout << "  num_tests=10                    --> number of times the algorithm will run\n\n";
+   std::cout << "  num_tests=10                    --> number of times the algorithm will run\n";
+   std::cout << "  seed=0                          --> (optional) fixed seed, test i uses stream i of it; reproducible with threads_per_test=1 and no large_population, 0 seeds from the clock\n";
+   std::cout << "  perf_counters=0                 --> (optional) 1 samples cycles, instructions, cache/branch misses and LLC loads per GA phase (Linux perf_event_open)\n";
+   std::cout << "  results_file=runs.csv           --> (optional) writes every run (genes, fitness, generations, stop reason, time) to this file\n";
+   std::cout << "  results_format=csv              --> (optional) results file format | available:  csv  |  binary (columnar blocks)\n";
+   std::cout << "  threads_per_test=0              --> (optional) threads inside each run, 0 lets the auto-tuner measure and choose\n";
+   std::cout << "  parallel_chunk=0                --> (optional) individuals per work chunk inside a parallel run, 0 lets the auto-tuner choose\n";
+   std::cout << "  trace_length=0                  --> (optional) generations of best/mean/worst/diversity/mutation kept per run and exported with the results, 0 disables\n";
+   std::cout << "  niching=none                    --> (optional) GA diversity for multimodal functions | available:  none  |  sharing  |  clearing  |  crowding\n";
+   std::cout << "  niche_radius=0.1                --> (optional) niche radius, in the domain scaled to the unit box\n";
+   std::cout << "  niche_capacity=1                --> (optional) individuals that keep their fitness in each clearing niche\n";
+   std::cout << "  local_search=none               --> (optional) memetic GA: local search on the best individuals | available:  none  |  coordinate  |  nelder_mead  |  lbfgs\n";
+   std::cout << "  local_search_interval=10        --> (optional) generations between local search rounds\n";
+   std::cout << "  local_search_elites=4           --> (optional) best individuals refined in each round, in parallel\n";
+   std::cout << "  local_search_evaluations=0      --> (optional) evaluation budget of each round, split among the elites, 0 uses 100 * dimensions\n";
+   std::cout << "  surrogate=none                  --> (optional) GA pre-screens children with a model of past evaluations | available:  none  |  knn  |  rbf\n";
+   std::cout << "  surrogate_fraction=0.25         --> (optional) share of the children that still gets a real evaluation\n";
+   std::cout << "  surrogate_archive=2048          --> (optional) evaluated genomes kept to train the surrogate\n";
+   std::cout << "  surrogate_neighbors=8           --> (optional) neighbors averaged by the knn surrogate\n";
+   std::cout << "  fitness_cache_size=0            --> (optional) entries in the fitness memoization cache, 0 disables it\n";
+   std::cout << "  boundary_handling=clamp         --> (optional) out-of-bounds genes | available:  clamp  |  reflect  |  wrap  |  random\n";
+   std::cout << "  engine=ga                       --> (optional) optimizer | available:  ga  |  de_rand1bin  |  de_best1bin  |  cmaes  |  nsga2 (multi-objective)\n";
+   std::cout << "  objective_function=zdt1         --> (optional) nsga2 test problem | available:  zdt1  |  zdt2  |  zdt3  |  dtlz2\n";
+   std::cout << "  objectives=3                    --> (optional) number of objectives of dtlz2\n";
+   std::cout << "  pareto_file=front.csv           --> (optional) nsga2 writes the Pareto front of every run to this file\n";
+   std::cout << "  differential_weight=0.5         --> (optional) DE mutation factor F\n";
+   std::cout << "  crossover_rate=0.9              --> (optional) DE binomial crossover rate CR\n";
+   std::cout << "  cma_lambda=0                    --> (optional) CMA-ES offspring per generation, 0 uses 4 + 3 ln(n)\n";
+   std::cout << "  schedule=linear                 --> (optional) mutation decay | available:  linear  |  exponential  |  cosine  |  adaptive (1/5 rule)\n";
+   std::cout << "  precision=double                --> (optional) GA gene type | available:  double  |  float  |  mixed (float + final double polish)\n";
+   std::cout << "  polish_evaluations=0            --> (optional) evaluation budget of the mixed precision polish, 0 uses 200 * dimensions\n";
+   std::cout << "  initialization=uniform          --> (optional) initial population sampling | available:  uniform  |  sobol  |  halton  |  lhs (latin hypercube)\n";
+   std::cout << "  large_population=0              --> (optional) 1 stores the GA population in flat chunks with parallel sort/selection, for millions of individuals\n";
+   std::cout << "  memory_budget_mb=0              --> (optional) large population mode aborts if its memory estimate exceeds this, 0 disables\n";
+   std::cout << "  out_of_core=0                   --> (optional) 1 keeps the large population genes in memory-mapped tile files, only fitness stays in RAM\n";
+   std::cout << "  tile_directory=/scratch         --> (optional) where out_of_core creates its tile files, defaults to the system temp directory\n";
+   std::cout << "  islands=0                       --> (optional) GA islands exchanging migrants in a ring, replaces num_tests when > 1\n";
+   std::cout << "  transport=loopback              --> (optional) island transport | available:  loopback (threads of this process)  |  tcp  |  unix\n";
+   std::cout << "  coordinator_address=host:5555   --> (optional) rank 0 address: host:port for tcp, socket path for unix\n";
+   std::cout << "  island_rank=0                   --> (optional) island of this process with tcp/unix, also accepted as '--rank=N' after the config file\n";
+   std::cout << "  migration_interval=50           --> (optional) generations between migrations\n";
+   std::cout << "  migration_size=2                --> (optional) best individuals sent to the next island on each migration\n";
+   std::cout << "  stop_fitness=1e-6               --> (optional) a GA run stops once its best reaches this; with islands the coordinator stops every island on the global best\n\n";
    std::cout << "  Note: Each parameter should be on a separate line, in the format 'parameter_name=value'.\n";
    std::cout << "  Modify the values as needed for your specific configuration.\n";
 }
@@ -8,6 +8,7 @@
 #include <tuple>
 #include <variant>
 #include <stdexcept>
+#include <ostream>
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
@@ -27,6 +28,10 @@ enum class TargetFunction {
     sphere,
     easom,
     mccormick,
+    rosenbrock,
+    schwefel,
+    griewank,
+    levy,
 
     max_functions
 };
@@ -39,18 +44,22 @@ namespace Constants {
         inline constexpr double pi{ 3.14159265358979323846 };
     }
 
-    inline constexpr std::tuple<Bounds, Bounds, Bounds, Bounds, BoundsPair> BOUNDS {
+    inline constexpr std::tuple<Bounds, Bounds, Bounds, Bounds, BoundsPair, Bounds, Bounds, Bounds, Bounds> BOUNDS {
         std::make_tuple (
             Bounds{-5.12, 5.12},
             Bounds{-5.0, 5.0},
             Bounds{-1000.0, 1000.0},
             Bounds{-100.0, 100.0},
-            BoundsPair{ {-1.5, 4.0}, {-3.0, 4.0} }
+            BoundsPair{ {-1.5, 4.0}, {-3.0, 4.0} },
+            Bounds{-5.0, 10.0},
+            Bounds{-500.0, 500.0},
+            Bounds{-600.0, 600.0},
+            Bounds{-10.0, 10.0}
         )
     };
 
     constexpr std::array<std::string_view, static_cast<size_t>(TargetFunction::max_functions)> functionNames {
-        "Rastrigin"sv, "Ackley"sv, "Sphere"sv, "Easom"sv, "McCormick"sv
+        "Rastrigin"sv, "Ackley"sv, "Sphere"sv, "Easom"sv, "McCormick"sv, "Rosenbrock"sv, "Schwefel"sv, "Griewank"sv, "Levy"sv
     };
 
 }
@@ -78,7 +87,135 @@ enum class SelectionMethod {
 enum class Points {
     one,
     two,
-    uniform
+    uniform,
+    arithmetic,
+    blx,        // BLX-alpha
+    sbx         // simulated binary crossover
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o algoritmo de otimização
+enum class Engine {
+    ga,
+    de_rand_1_bin,
+    de_best_1_bin,
+    cmaes,
+    nsga2 // multiobjetivo
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o decaimento da taxa e força de mutação
+enum class MutationSchedule {
+    linear,
+    exponential,
+    cosine,
+    adaptive // regra de 1/5 de sucesso
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar a precisão dos genes do algoritmo genético
+enum class Precision {
+    float64,
+    float32,
+    mixed // float32 + polimento final em double
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar a amostragem da população inicial
+enum class InitSampling {
+    uniform,
+    sobol,
+    halton,
+    lhs // Latin hypercube
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o transporte entre ilhas do modelo distribuído
+enum class TransportType {
+    loopback,    // ilhas como threads de um mesmo processo
+    tcp,
+    unix_socket
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o tratamento de genes fora dos limites
+enum class BoundaryHandling {
+    clamp,
+    reflect,
+    wrap,
+    reinit
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar as funções de teste multiobjetivo (engine=nsga2)
+enum class ObjectiveFunction {
+    zdt1,   // frente convexa
+    zdt2,   // frente côncava
+    zdt3,   // frente desconexa
+    dtlz2   // esfera com `objectives` objetivos
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o motivo de parada de uma execução
+enum class StopReason {
+    iterations,   // todas as gerações foram executadas
+    converged,    // passo do CMA-ES abaixo da tolerância
+    stop_fitness  // o GA (ou, nas ilhas, o melhor global) atingiu stop_fitness
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o formato do arquivo de resultados
+enum class ResultsFormat {
+    csv,
+    binary // blocos colunares, ver ResultsSink.h
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o modelo substituto da pré-triagem de filhos (ver Surrogate.h)
+enum class SurrogateType {
+    none,
+    knn,   // média ponderada dos k vizinhos mais próximos
+    rbf    // interpolação por funções de base radial gaussianas
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar a busca local aplicada às elites no modo memético (ver local_search.h)
+enum class LocalSearch {
+    none,
+    coordinate,    // busca por padrões coordenada a coordenada
+    nelder_mead,   // simplex de Nelder-Mead
+    lbfgs          // L-BFGS com gradiente por diferenças finitas
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o método de nichos para funções multimodais (ver niching.h)
+enum class Niching {
+    none,
+    sharing,    // fitness compartilhado entre vizinhos dentro do raio
+    clearing,   // só os melhores de cada nicho mantêm o fitness
+    crowding    // crowding determinístico: o filho só substitui o pai mais próximo
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar a transformação das funções alvo no estilo CEC (ver FunctionTransform.h)
+enum class TransformType {
+    none,
+    shifted,           // ótimo deslocado para um ponto sorteado do domínio
+    rotated,           // coordenadas giradas por uma matriz ortogonal: a função deixa de ser separável
+    shifted_rotated
 };
 
 // -------------------------------------------------------------------------------------------------------------------------------------
@@ -109,6 +246,77 @@ constexpr std::string_view getFunctionName(TargetFunction function) {
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
+// Sobrecarga do operador << para Engine
+inline std::ostream& operator<<(std::ostream& os, Engine engine) {
+    constexpr std::array<std::string_view, 5> engineNames{ "Genetic Algorithm"sv, "DE/rand/1/bin"sv, "DE/best/1/bin"sv, "CMA-ES"sv, "NSGA-II"sv };
+    return os << engineNames[static_cast<std::size_t>(engine)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Sobrecarga do operador << para Precision
+inline std::ostream& operator<<(std::ostream& os, Precision precision) {
+    constexpr std::array<std::string_view, 3> precisionNames{ "double"sv, "float"sv, "float + double polish"sv };
+    return os << precisionNames[static_cast<std::size_t>(precision)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Função para obter o nome do motivo de parada
+constexpr std::string_view getStopReasonName(StopReason reason) {
+    constexpr std::array<std::string_view, 3> reasonNames{ "iterations"sv, "converged"sv, "stop_fitness"sv };
+    return reasonNames[static_cast<std::size_t>(reason)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Sobrecarga do operador << para ObjectiveFunction
+inline std::ostream& operator<<(std::ostream& os, ObjectiveFunction function) {
+    constexpr std::array<std::string_view, 4> objectiveNames{ "ZDT1"sv, "ZDT2"sv, "ZDT3"sv, "DTLZ2"sv };
+    return os << objectiveNames[static_cast<std::size_t>(function)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Sobrecarga do operador << para SurrogateType
+inline std::ostream& operator<<(std::ostream& os, SurrogateType type) {
+    constexpr std::array<std::string_view, 3> surrogateNames{ "none"sv, "k-NN"sv, "RBF"sv };
+    return os << surrogateNames[static_cast<std::size_t>(type)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Sobrecarga do operador << para LocalSearch
+inline std::ostream& operator<<(std::ostream& os, LocalSearch method) {
+    constexpr std::array<std::string_view, 4> localSearchNames{ "none"sv, "coordinate descent"sv, "Nelder-Mead"sv, "L-BFGS"sv };
+    return os << localSearchNames[static_cast<std::size_t>(method)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Sobrecarga do operador << para Niching
+inline std::ostream& operator<<(std::ostream& os, Niching niching) {
+    constexpr std::array<std::string_view, 4> nichingNames{ "none"sv, "fitness sharing"sv, "clearing"sv, "deterministic crowding"sv };
+    return os << nichingNames[static_cast<std::size_t>(niching)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Sobrecarga do operador << para TransformType
+inline std::ostream& operator<<(std::ostream& os, TransformType transform) {
+    constexpr std::array<std::string_view, 4> transformNames{ "none"sv, "shifted"sv, "rotated"sv, "shifted + rotated"sv };
+    return os << transformNames[static_cast<std::size_t>(transform)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Sobrecarga do operador << para StopReason
+inline std::ostream& operator<<(std::ostream& os, StopReason reason) {
+    return os << getStopReasonName(reason);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
 // Sobrecarga do operador << para TargetFunction
 inline std::ostream& operator<<(std::ostream& os, TargetFunction function) {
     return os << getFunctionName(function);
@@ -148,6 +356,14 @@ inline BoundVariant getBound(TargetFunction f) {
             return std::get<static_cast<int>(easom)>(Constants::BOUNDS);
         case TargetFunction::mccormick:
             return std::get<static_cast<int>(mccormick)>(Constants::BOUNDS);
+        case TargetFunction::rosenbrock:
+            return std::get<static_cast<int>(rosenbrock)>(Constants::BOUNDS);
+        case TargetFunction::schwefel:
+            return std::get<static_cast<int>(schwefel)>(Constants::BOUNDS);
+        case TargetFunction::griewank:
+            return std::get<static_cast<int>(griewank)>(Constants::BOUNDS);
+        case TargetFunction::levy:
+            return std::get<static_cast<int>(levy)>(Constants::BOUNDS);
         default:
             throw std::invalid_argument("Invalid target function");
     }
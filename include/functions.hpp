@@ -1,24 +1,29 @@
 #pragma once
 
 #include <vector>
+#include <span>
+#include <array>
 #include <cmath>
 #include <numeric>
-#include <unordered_map>
-#include <functional>
 #include "constants.h"
 
+// -------------------------------------------------------------------------------------------------------------------------------------
+// Every function is templated on the gene type and computes in it, so float genomes get float math. The span
+// extent is a template parameter too: with a fixed extent (FixedChromosome) the loops have a constant trip count.
 // -------------------------------------------------------------------------------------------------------------------------------------
 
 /// @brief  Rastrigin benchmark function
 /// @param x parameters array
 /// @return f(x...) 
-inline double rastrigin_fnc(const std::vector<double>& x)
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double rastrigin_fnc(std::span<const T, E> x)
 {
-    constexpr double A{ 10 };
-    double result{ A * x.size() };
+    constexpr T A{ 10 };
+    constexpr T twoPi{ static_cast<T>(2 * Constants::Math::pi) };
+    T result{ A * static_cast<T>(x.size()) };
 
     for(auto xi : x)
-        result += (xi * xi - A * std::cos(2 * Constants::Math::pi * xi));
+        result += (xi * xi - A * std::cos(twoPi * xi));
     
     return result;
 }
@@ -28,22 +33,23 @@ inline double rastrigin_fnc(const std::vector<double>& x)
 /// @brief  Ackley benchmark function
 /// @param x parameters array
 /// @return f(x...) 
-inline double ackley_fnc(const std::vector<double>& v)
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double ackley_fnc(std::span<const T, E> v)
 {
-    constexpr double A{ 20 };
-    constexpr double B{ 0.2 };
-    constexpr double C{ 2 * Constants::Math::pi };
-    const std::size_t nDim{ v.size() };
+    constexpr T A{ 20 };
+    constexpr T B{ static_cast<T>(0.2) };
+    constexpr T C{ static_cast<T>(2 * Constants::Math::pi) };
+    const T nDim{ static_cast<T>(v.size()) };
 
-    double term1{ -A * std::exp(-B * std::sqrt(std::accumulate(v.begin(), v.end(), 0.0, [](double a, double b) { return a + b * b; }) / nDim)) };
+    T term1{ -A * std::exp(-B * std::sqrt(std::accumulate(v.begin(), v.end(), T{ 0 }, [](T a, T b) { return a + b * b; }) / nDim)) };
 
-    double sum_cos = 0.0;
+    T sum_cos{ 0 };
     for (const auto& x: v) 
         sum_cos += std::cos(C * x);
     
-    double term2{ -std::exp(sum_cos / nDim) };
+    T term2{ -std::exp(sum_cos / nDim) };
 
-    return term1 + term2 + std::exp(1) + A;
+    return term1 + term2 + std::exp(T{ 1 }) + A;
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
@@ -51,9 +57,10 @@ inline double ackley_fnc(const std::vector<double>& v)
 /// @brief  Sphere benchmark function
 /// @param x parameters array
 /// @return f(x...) 
-inline double sphere_fnc(const std::vector<double>& x)
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double sphere_fnc(std::span<const T, E> x)
 {
-    double result{ 0.0 };
+    T result{ 0 };
 
     for(auto xi : x)
         result += xi * xi;
@@ -66,13 +73,14 @@ inline double sphere_fnc(const std::vector<double>& x)
 /// @brief  Easom benchmark function
 /// @param x parameters array
 /// @return f(x...) 
-inline double easom_fnc(const std::vector<double>& v)
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double easom_fnc(std::span<const T, E> v)
 {
+    constexpr T pi{ static_cast<T>(Constants::Math::pi) };
     const auto x{ v[0] };
     const auto y{ v[1] };
 
-    return -std::cos(x) * std::cos(y) * std::exp(-((x - Constants::Math::pi) * (x - Constants::Math::pi)
-        + (y - Constants::Math::pi) * (y - Constants::Math::pi)));
+    return -std::cos(x) * std::cos(y) * std::exp(-((x - pi) * (x - pi) + (y - pi) * (y - pi)));
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
@@ -80,25 +88,169 @@ inline double easom_fnc(const std::vector<double>& v)
 /// @brief  McCormick benchmark function
 /// @param x parameters array
 /// @return f(x...) 
-inline double mccormick_fnc(const std::vector<double>& v)
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double mccormick_fnc(std::span<const T, E> v)
 {
     const auto x{ v[0] };
     const auto y{ v[1] };
 
-    return std::sin(x + y) + (x - y) * (x - y) - 1.5*x + 2.5*y + 1;
+    return std::sin(x + y) + (x - y) * (x - y) - T{ 1.5 } * x + T{ 2.5 } * y + T{ 1 };
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief  Rosenbrock benchmark function
+/// @param x parameters array
+/// @return f(x...) 
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double rosenbrock_fnc(std::span<const T, E> x)
+{
+    T result{ 0 };
+
+    for(std::size_t i {0}; i + 1 < x.size(); ++i)
+    {
+        const T valley{ x[i + 1] - x[i] * x[i] };
+        const T slope{ x[i] - T{ 1 } };
+        result += T{ 100 } * valley * valley + slope * slope;
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief  Schwefel benchmark function, with the CEC 2014 extension outside [-500, 500]
+/// @param x parameters array
+/// @return f(x...) 
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double schwefel_fnc(std::span<const T, E> x)
+{
+    constexpr T limit{ 500 };
+    const T n{ static_cast<T>(x.size()) };
+    T result{ static_cast<T>(418.9828872724338) * n };
+
+    // Fora do domínio a função seria ilimitada (coordenadas giradas saem dele): reflete e penaliza
+    for(auto xi : x)
+    {
+        if(xi > limit)
+        {
+            const T folded{ limit - std::fmod(xi, limit) };
+            result -= folded * std::sin(std::sqrt(std::abs(folded))) - (xi - limit) * (xi - limit) / (T{ 10000 } * n);
+        }
+        else if(xi < -limit)
+        {
+            const T folded{ std::fmod(std::abs(xi), limit) - limit };
+            result -= folded * std::sin(std::sqrt(std::abs(folded))) - (xi + limit) * (xi + limit) / (T{ 10000 } * n);
+        }
+        else
+            result -= xi * std::sin(std::sqrt(std::abs(xi)));
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief  Griewank benchmark function
+/// @param x parameters array
+/// @return f(x...) 
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double griewank_fnc(std::span<const T, E> x)
+{
+    T sum{ 0 };
+    T product{ 1 };
+
+    for(std::size_t i {0}; i < x.size(); ++i)
+    {
+        sum += x[i] * x[i];
+        product *= std::cos(x[i] / std::sqrt(static_cast<T>(i + 1)));
+    }
+
+    return T{ 1 } + sum / T{ 4000 } - product;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief  Levy benchmark function
+/// @param x parameters array
+/// @return f(x...) 
+template <typename T, std::size_t E = std::dynamic_extent>
+inline double levy_fnc(std::span<const T, E> x)
+{
+    constexpr T pi{ static_cast<T>(Constants::Math::pi) };
+    const auto w{ [&x](std::size_t i) { return T{ 1 } + (x[i] - T{ 1 }) / T{ 4 }; } };
+
+    const T first{ std::sin(pi * w(0)) };
+    T result{ first * first };
+
+    for(std::size_t i {0}; i + 1 < x.size(); ++i)
+    {
+        const T wi{ w(i) };
+        const T s{ std::sin(pi * wi + T{ 1 }) };
+        result += (wi - T{ 1 }) * (wi - T{ 1 }) * (T{ 1 } + T{ 10 } * s * s);
+    }
+
+    const T last{ w(x.size() - 1) };
+    const T s{ std::sin(2 * pi * last) };
+    result += (last - T{ 1 }) * (last - T{ 1 }) * (T{ 1 } + s * s);
+
+    return result;
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
 namespace Benchmark {
-    using FncPtr = std::function<double(const std::vector<double>&)>;
-    using enum TargetFunction;
+    template <typename T>
+    using FncPtr = double (*)(std::span<const T>);
     
-    inline std::unordered_map<TargetFunction, FncPtr> target_functions {
-        {rastrigin, rastrigin_fnc},
-        {ackley, ackley_fnc},
-        {sphere, sphere_fnc},
-        {easom, easom_fnc},
-        {mccormick, mccormick_fnc}
+    // Indexed by TargetFunction: a plain table lookup instead of hashing into a std::function map
+    template <typename T>
+    inline constexpr std::array<FncPtr<T>, static_cast<std::size_t>(TargetFunction::max_functions)> target_functions {
+        rastrigin_fnc<T>,
+        ackley_fnc<T>,
+        sphere_fnc<T>,
+        easom_fnc<T>,
+        mccormick_fnc<T>,
+        rosenbrock_fnc<T>,
+        schwefel_fnc<T>,
+        griewank_fnc<T>,
+        levy_fnc<T>
+    };
+
+    template <typename T>
+    constexpr FncPtr<T> function(TargetFunction fnc)
+    {
+        return target_functions<T>[static_cast<std::size_t>(fnc)];
+    }
+
+    template <typename T, std::size_t D>
+    using FixedFncPtr = double (*)(std::span<const T, D>);
+
+    // Same table for genomes of exactly D genes; a constexpr entry is a direct (inlinable) call
+    template <typename T, std::size_t D>
+    inline constexpr std::array<FixedFncPtr<T, D>, static_cast<std::size_t>(TargetFunction::max_functions)> fixed_functions {
+        rastrigin_fnc<T, D>,
+        ackley_fnc<T, D>,
+        sphere_fnc<T, D>,
+        easom_fnc<T, D>,
+        mccormick_fnc<T, D>,
+        rosenbrock_fnc<T, D>,
+        schwefel_fnc<T, D>,
+        griewank_fnc<T, D>,
+        levy_fnc<T, D>
     };
+
+    /// @brief Coordinate `i` of the global minimum, which shifted and rotated variants move to their shift vector.
+    inline double optimum(TargetFunction fnc, std::size_t i)
+    {
+        switch(fnc)
+        {
+            case TargetFunction::easom:      return Constants::Math::pi;
+            case TargetFunction::mccormick:  return i == 0 ? -0.54719 : -1.54719;
+            case TargetFunction::rosenbrock: return 1.0;
+            case TargetFunction::schwefel:   return 420.9687462275036;
+            case TargetFunction::levy:       return 1.0;
+            default:                         return 0.0;
+        }
+    }
 }
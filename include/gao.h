@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "Parameters.h"
+
+// libgao: the genetic algorithm as an embeddable ask/tell optimizer.
+//
+// The host owns the objective. ask() hands out a contiguous row-major batch of genomes
+// (batchSize() x dimensions()), the host evaluates it however it likes (its own thread pool, SIMD,
+// a GPU, a remote service) and tell() takes the fitness array back, in the same row order.
+// Lower fitness is better. The same selection, crossover, mutation and schedule settings of
+// Parameters apply; the target_function, engine and multi-test/island keys are ignored.
+// Each optimizer draws from its own random engine, seeded from p.seed (a fresh seed when it is 0), so
+// the same seed and the same fitness values give the same run whichever thread calls ask().
+//
+//     gao::Optimizer opt{ params, lower, upper };
+//     while(!opt.done())
+//     {
+//         std::span<const double> genomes{ opt.ask() };
+//         evaluate(genomes, fitness);
+//         opt.tell(fitness);
+//     }
+//
+// A plain C interface over the same object is in gao_c.h.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace gao {
+
+    class Optimizer
+    {
+    public:
+        /// @brief Searches the box of p.target_function in p.dimensions dimensions.
+        explicit Optimizer(const Parameters& p);
+
+        /// @brief Searches the box [lower, upper]; its size gives the number of dimensions.
+        Optimizer(const Parameters& p, std::vector<double> lower, std::vector<double> upper);
+
+        ~Optimizer();
+        Optimizer(Optimizer&&) noexcept;
+        Optimizer& operator=(Optimizer&&) noexcept;
+
+        std::size_t             dimensions() const;
+
+        /// @brief Rows of the next ask(): the whole population first, then the non-elite children.
+        std::size_t             batchSize() const;
+
+        /// @brief Genomes to evaluate; stays valid until the next tell(). Asking twice returns the same batch.
+        std::span<const double> ask();
+
+        /// @brief Fitness of every row of the last ask(), in order. Throws std::invalid_argument on a size mismatch.
+        /// A NaN (failed evaluation) is taken as +infinity, the worst possible fitness.
+        void                    tell(std::span<const double> fitness);
+
+        /// @brief Completed generations (the initial population does not count).
+        int                     generation() const;
+        std::span<const double> bestGenes() const;
+        double                  bestFitness() const;
+
+        /// @brief nIterations generations done, or stop_fitness reached when it is set.
+        bool                    done() const;
+
+    private:
+        struct State;
+        std::unique_ptr<State> m_state;
+    };
+
+}
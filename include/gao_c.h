@@ -0,0 +1,67 @@
+#ifndef GAO_C_H
+#define GAO_C_H
+
+#include <stddef.h>
+
+/* C interface of libgao, see gao.h for the ask/tell protocol.
+ * Functions returning int give 0 on success and -1 on error; gao_last_error() describes the last
+ * error of the calling thread. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct gao_optimizer gao_optimizer;
+
+/* Same meaning as the config file keys of the same name; enums use the order of the config values. */
+typedef struct gao_config
+{
+    int    dimensions;
+    int    pop_size;
+    int    generations;              /* number_of_iterations */
+    double initial_mutation_rate;
+    double final_mutation_rate;
+    double initial_mutation_strength;
+    double final_mutation_strength;
+    double elite_fraction;
+    int    selection_method;         /* 0 tournament, 1 fps, 2 ranking */
+    int    tournament_size;
+    int    crossover;                /* 0 one, 1 two, 2 uniform, 3 arithmetic, 4 blx, 5 sbx */
+    double blx_alpha;
+    double sbx_eta;
+    int    schedule;                 /* 0 linear, 1 exponential, 2 cosine, 3 adaptive */
+    int    boundary_handling;        /* 0 clamp, 1 reflect, 2 wrap, 3 reinit */
+    int    stop_at_fitness;
+    double stop_fitness;
+    unsigned long long seed;         /* 0 seeds each optimizer afresh; otherwise the same seed repeats the run */
+} gao_config;
+
+void           gao_config_defaults(gao_config* config);
+
+/* lower/upper hold config->dimensions values each. NULL (see gao_last_error) if an enum field is out of range. */
+gao_optimizer* gao_create(const gao_config* config, const double* lower, const double* upper);
+
+/* Parameters from a gao config file; the search box is the one of its target_function.
+ * NULL (see gao_last_error) if the file cannot be read or holds a malformed number. */
+gao_optimizer* gao_create_from_file(const char* path);
+
+void           gao_destroy(gao_optimizer* optimizer);
+
+size_t         gao_dimensions(const gao_optimizer* optimizer);
+
+/* Row-major batch of *count genomes (each gao_dimensions() long), valid until the next gao_tell */
+const double*  gao_ask(gao_optimizer* optimizer, size_t* count);
+int            gao_tell(gao_optimizer* optimizer, const double* fitness, size_t count);
+
+int            gao_generation(const gao_optimizer* optimizer);
+double         gao_best_fitness(const gao_optimizer* optimizer);
+const double*  gao_best_genes(const gao_optimizer* optimizer);
+int            gao_done(const gao_optimizer* optimizer);
+
+const char*    gao_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GAO_C_H */
@@ -3,49 +3,156 @@
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-Chromosome::Chromosome(const std::vector<double>& genes)
+namespace {
+
+    // Contador por thread: sem atomics no caminho da avaliação
+    thread_local std::uint64_t evaluations{ 0 };
+
+}
+
+std::uint64_t evaluationCount()
+{
+    return evaluations;
+}
+
+void countEvaluations(std::uint64_t count)
+{
+    evaluations += count;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+BasicChromosome<T>::BasicChromosome(const std::vector<T>& genes)
     : m_chromosome{ genes }, m_fitness_value{ 10000.0 } 
     {
     }
 
-Chromosome::Chromosome(std::vector<double>&& genes) noexcept
+template <typename T>
+BasicChromosome<T>::BasicChromosome(std::vector<T>&& genes) noexcept
         : m_chromosome{ std::move(genes) }, m_fitness_value{ 10000.0 }
     {
     }
 
-Chromosome::Chromosome(const Chromosome& other)
+template <typename T>
+BasicChromosome<T>::BasicChromosome(const BasicChromosome& other)
     : m_chromosome{ other.m_chromosome }, m_fitness_value{ other.m_fitness_value }
     {
     }
 
-Chromosome::Chromosome(Chromosome&& other) noexcept 
+template <typename T>
+BasicChromosome<T>::BasicChromosome(BasicChromosome&& other) noexcept 
     : m_chromosome{ std::move(other.m_chromosome) }, m_fitness_value{ other.m_fitness_value }
     {
     }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-void Chromosome::evaluate_solution(TargetFunction fnc)
+template <typename T>
+void BasicChromosome<T>::evaluate_solution(TargetFunction fnc)
 {
-    m_fitness_value = Benchmark::target_functions[fnc](m_chromosome);
+    m_fitness_value = Benchmark::objective<T>(fnc)(m_chromosome);
+    ++evaluations;
+}
+
+/// @brief Evaluates through the fitness cache when one is given.
+template <typename T>
+void BasicChromosome<T>::evaluate_solution(TargetFunction fnc, FitnessCache* cache)
+{
+    if(!cache)
+    {
+        evaluate_solution(fnc);
+        return;
+    }
+
+    const FitnessCache::Key key{ FitnessCache::key(m_chromosome.data(), m_chromosome.size() * sizeof(T)) };
+
+    if(cache->lookup(key, m_fitness_value))
+        return;
+
+    evaluate_solution(fnc);
+    cache->insert(key, m_fitness_value);
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-void Chromosome::mutate(double mRate, double mStrength)
+/// @brief Gaussian mutation.
+/// @return true if at least one gene was changed
+template <typename T>
+bool BasicChromosome<T>::mutate(double mRate, double mStrength)
 {
-    std::normal_distribution<> dist(0, mStrength);
+    std::normal_distribution<T> dist(0, static_cast<T>(mStrength));
+    bool changed{ false };
 
     for(auto& gene: m_chromosome)
+    {
         if(Random::rand() < mRate)
+        {
             gene += dist(Random::mt);
+            changed = true;
+        }
+    }
+
+    return changed;
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-void Chromosome::mutate_vm(double mRate, double mStrength)
+/// @brief Becomes a mutated, repaired copy of `source` in one pass over the genes.
+///
+/// Same draws as operator= followed by mutate() and checkBounds(), but done one tile of genes at a time:
+/// each tile is copied, mutated and repaired while it is in L1 instead of walking a wide genome three times.
+/// Reinit repair draws from the same generator as the mutation, so with that mode the repair waits until
+/// every tile is mutated, keeping the draw order of the untiled pass.
+/// @return true if at least one gene was changed
+template <typename T>
+bool BasicChromosome<T>::mutateFrom(const BasicChromosome& source, double mRate, double mStrength, const SearchBounds& bounds)
 {
-    std::normal_distribution<> dist(0, mStrength);
+    constexpr std::size_t tileGenes{ 1024 };
+
+    const std::size_t n{ source.m_chromosome.size() };
+    m_chromosome.resize(n);
+    m_fitness_value = source.m_fitness_value;
+
+    std::mt19937& rng{ Random::mt };
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<T> dist(0, static_cast<T>(mStrength));
+    const bool deferRepair{ bounds.mode() == BoundaryHandling::reinit };
+    bool changed{ false };
+
+    for(std::size_t first {0}; first < n; first += tileGenes)
+    {
+        const std::size_t count{ std::min(tileGenes, n - first) };
+        std::copy(source.m_chromosome.begin() + first, source.m_chromosome.begin() + first + count, m_chromosome.begin() + first);
+
+        bool tileChanged{ false };
+        for(std::size_t j {first}; j < first + count; ++j)
+        {
+            if(unit(rng) < mRate)
+            {
+                m_chromosome[j] += dist(rng);
+                tileChanged = true;
+            }
+        }
+
+        if(tileChanged && !deferRepair)
+            bounds.repairTile(m_chromosome.data(), first, count);
+
+        changed = changed || tileChanged;
+    }
+
+    if(changed && deferRepair)
+        bounds.repair(m_chromosome.data(), n);
+
+    return changed;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void BasicChromosome<T>::mutate_vm(double mRate, double mStrength)
+{
+    std::normal_distribution<T> dist(0, static_cast<T>(mStrength));
 
     for(auto& gene: m_chromosome)
     {
@@ -61,48 +168,28 @@ void Chromosome::mutate_vm(double mRate, double mStrength)
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-void Chromosome::checkBounds(TargetFunction fnc) 
+template <typename T>
+void BasicChromosome<T>::checkBounds(const SearchBounds& bounds) 
 {
-    auto bounds{ getBound(fnc) };
-    
-    if (fnc == TargetFunction::mccormick) 
-    {
-        auto bounds_pair{ std::get<BoundsPair>(bounds) };
-
-        auto [x_lower, x_upper]{ std::get<static_cast<int>(BoundType::lower)>(bounds_pair) };
-        auto [y_lower, y_upper]{ std::get<static_cast<int>(BoundType::higher)>(bounds_pair) };
-
-        for (std::size_t i {0}; i < m_chromosome.size(); ++i) 
-        {
-            if(i == 0) 
-                m_chromosome[i] = std::clamp(m_chromosome[i], x_lower, x_upper);
-            else if(i == 1)
-                m_chromosome[i] = std::clamp(m_chromosome[i], y_lower, y_upper);
-        }
-    } 
-    else 
-    {
-        auto bounds_single{ std::get<Bounds>(bounds) };
-        auto [lower, upper]{ bounds_single };
-
-        for (auto& gene : m_chromosome) 
-            gene = std::clamp(gene, lower, upper);
-    }
+    bounds.repair(m_chromosome.data(), m_chromosome.size());
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-bool Chromosome::operator<(const Chromosome& other) const 
+template <typename T>
+bool BasicChromosome<T>::operator<(const BasicChromosome& other) const 
 {
     return m_fitness_value < other.m_fitness_value;
 }
 
-bool Chromosome::operator==(const Chromosome& other) const 
+template <typename T>
+bool BasicChromosome<T>::operator==(const BasicChromosome& other) const 
 {
     return m_chromosome == other.m_chromosome;
 }
 
-Chromosome& Chromosome::operator=(const Chromosome& other) 
+template <typename T>
+BasicChromosome<T>& BasicChromosome<T>::operator=(const BasicChromosome& other) 
 {
     if(this != &other) 
     {
@@ -112,23 +199,73 @@ Chromosome& Chromosome::operator=(const Chromosome& other)
     return *this;
 }
 
-std::ostream& operator<<(std::ostream& os, const Chromosome& chromosome) 
+template <typename T>
+BasicChromosome<T>& BasicChromosome<T>::operator=(BasicChromosome&& other) noexcept 
+{
+    if(this != &other) 
+    {
+        m_chromosome = std::move(other.m_chromosome);
+        m_fitness_value = other.m_fitness_value;
+    }
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void evaluateBatch(std::span<BasicChromosome<T>* const> individuals, TargetFunction fnc, FitnessCache* cache)
 {
-    os << "[";
-    for (std::size_t i {0}; i < chromosome.m_chromosome.size(); ++i) 
+    const FunctionTransform* transform{ FunctionTransform::active(fnc) };
+
+    // Sem rotação não há produto de matrizes para compartilhar
+    if(!transform || !transform->rotated())
+    {
+        for(BasicChromosome<T>* individual : individuals)
+            individual->evaluate_solution(fnc, cache);
+        return;
+    }
+
+    thread_local std::vector<BasicChromosome<T>*> pending{};
+    thread_local std::vector<FitnessCache::Key> keys{};
+    thread_local std::vector<const T*> genomes{};
+    thread_local std::vector<double> fitness{};
+    pending.clear();
+    keys.clear();
+    genomes.clear();
+
+    for(BasicChromosome<T>* individual : individuals)
     {
-        os << chromosome.m_chromosome[i];
-        if(i != chromosome.m_chromosome.size() - 1) 
-            os << ", ";
+        if(cache)
+        {
+            const FitnessCache::Key key{ FitnessCache::key(individual->genes().data(), individual->size() * sizeof(T)) };
+            double cached{};
+            if(cache->lookup(key, cached))
+            {
+                individual->set_fitness(cached);
+                continue;
+            }
+            keys.push_back(key);
+        }
+
+        pending.push_back(individual);
+        genomes.push_back(individual->genes().data());
     }
 
-    os << "]";
-    
-    return os;
+    fitness.resize(pending.size());
+    transform->evaluateBlock(std::span<const T* const>(genomes), std::span<double>(fitness));
+    evaluations += pending.size();
+
+    for(std::size_t k {0}; k < pending.size(); ++k)
+    {
+        pending[k]->set_fitness(fitness[k]);
+        if(cache)
+            cache->insert(keys[k], fitness[k]);
+    }
 }
 
-// void swap(Chromosome& first, Chromosome& second) noexcept {
-//     using std::swap;
-//     swap(first.m_chromosome, second.m_chromosome);
-//     swap(first.m_fitness_value, second.m_fitness_value);
-// }
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template class BasicChromosome<float>;
+template class BasicChromosome<double>;
+template void evaluateBatch<float>(std::span<BasicChromosome<float>* const>, TargetFunction, FitnessCache*);
+template void evaluateBatch<double>(std::span<BasicChromosome<double>* const>, TargetFunction, FitnessCache*);
@@ -1,36 +1,94 @@
 #pragma once
 
 #include <vector>
+#include <span>
 #include "Random.h"
 #include "functions.hpp"
+#include "FunctionTransform.h"
+#include "FitnessCache.h"
+#include "SearchBounds.h"
 
-class Chromosome
+/// @brief Individual of the population, templated on the gene scalar type (float or double).
+///
+/// Fitness is always kept in double regardless of the gene type.
+template <typename T>
+class BasicChromosome
 {
 public:
-    Chromosome() = default;
-    Chromosome(const std::vector<double>& genes);
-    Chromosome(std::vector<double>&& genes) noexcept;
-    Chromosome(const Chromosome& other);
-    Chromosome(Chromosome&& other) noexcept;
-    ~Chromosome() = default;
+    using value_type = T;
+
+    BasicChromosome() = default;
+    BasicChromosome(const std::vector<T>& genes);
+    BasicChromosome(std::vector<T>&& genes) noexcept;
+    BasicChromosome(const BasicChromosome& other);
+    BasicChromosome(BasicChromosome&& other) noexcept;
+    template <typename U>
+    explicit BasicChromosome(const BasicChromosome<U>& other);
+    ~BasicChromosome() = default;
 
     void                       evaluate_solution(TargetFunction fnc);
-    void                       mutate(double mRate, double mStrength);
+    void                       evaluate_solution(TargetFunction fnc, FitnessCache* cache);
+    bool                       mutate(double mRate, double mStrength);
     void                       mutate_vm(double mRate, double mStrength);
-    void                       checkBounds(TargetFunction target_fnc);
+    bool                       mutateFrom(const BasicChromosome& source, double mRate, double mStrength, const SearchBounds& bounds);
+    void                       checkBounds(const SearchBounds& bounds);
     double                     get_fitness() const { return m_fitness_value; }
+    void                       set_fitness(double fitness) { m_fitness_value = fitness; }   // evaluated outside, e.g. by an ask/tell host
     std::size_t                size() const { return m_chromosome.size(); }
-    const std::vector<double>& get_genes_array() const { return m_chromosome; }
+    const std::vector<T>&      get_genes_array() const { return m_chromosome; }
+    std::vector<T>&            get_genes_array() { return m_chromosome; }
+    std::span<const T>         genes() const { return m_chromosome; }
+
+    bool operator<(const BasicChromosome& other) const;
+    bool operator==(const BasicChromosome& other) const;
+    BasicChromosome& operator=(const BasicChromosome& other);
+    BasicChromosome& operator=(BasicChromosome&& other) noexcept;
 
-    bool operator<(const Chromosome& other) const;
-    bool operator==(const Chromosome& other) const;
-    Chromosome& operator=(const Chromosome& other);
+    friend std::ostream& operator<<(std::ostream& os, const BasicChromosome& chromosome)
+    {
+        os << "[";
+        for (std::size_t i {0}; i < chromosome.m_chromosome.size(); ++i) 
+        {
+            os << chromosome.m_chromosome[i];
+            if(i != chromosome.m_chromosome.size() - 1) 
+                os << ", ";
+        }
 
-    // friend void swap(Chromosome& first, Chromosome& second) noexcept;
-    friend std::ostream& operator<<(std::ostream& os, const Chromosome& chromosome);
+        os << "]";
+        
+        return os;
+    }
     
 private:
-    std::vector<double> m_chromosome{};
+    template <typename U> friend class BasicChromosome;
+
+    std::vector<T> m_chromosome{};
     double m_fitness_value{};
 
 };
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+template <typename U>
+BasicChromosome<T>::BasicChromosome(const BasicChromosome<U>& other)
+    : m_chromosome(other.m_chromosome.begin(), other.m_chromosome.end()), m_fitness_value{ other.m_fitness_value }
+    {
+    }
+
+using Chromosome = BasicChromosome<double>;
+
+/// @brief Real fitness evaluations made by the calling thread so far; cache hits are not counted.
+std::uint64_t evaluationCount();
+/// @brief Adds evaluations made without a BasicChromosome (e.g. on FixedChromosome rows) to evaluationCount().
+void countEvaluations(std::uint64_t count);
+
+template <typename T>
+using Population = std::vector<BasicChromosome<T>>;
+
+/// @brief Evaluates every individual through the cache; with a rotated objective the cache misses are rotated as one block.
+template <typename T>
+void evaluateBatch(std::span<BasicChromosome<T>* const> individuals, TargetFunction fnc, FitnessCache* cache);
+
+extern template class BasicChromosome<float>;
+extern template class BasicChromosome<double>;
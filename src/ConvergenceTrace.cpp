@@ -0,0 +1,68 @@
+#include <cmath>
+#include "ConvergenceTrace.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+PopulationMoments& PopulationMoments::operator+=(const PopulationMoments& other)
+{
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+
+    for(std::size_t j {0}; j < m_geneSum.size() && j < other.m_geneSum.size(); ++j)
+    {
+        m_geneSum[j] += other.m_geneSum[j];
+        m_geneSumSq[j] += other.m_geneSumSq[j];
+    }
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+GenerationStats PopulationMoments::stats(int generation, double mutationRate, double mutationStrength) const
+{
+    GenerationStats s{ generation, m_min, 0.0, m_max, 0.0, mutationRate, mutationStrength };
+
+    if(m_count == 0)
+        return s;
+
+    const double count{ static_cast<double>(m_count) };
+    s.mean = m_sum / count;
+
+    double deviation{ 0.0 };
+    for(std::size_t j {0}; j < m_geneSum.size(); ++j)
+    {
+        const double mean{ m_geneSum[j] / count };
+        deviation += std::sqrt(std::max(0.0, m_geneSumSq[j] / count - mean * mean));
+    }
+
+    s.diversity = m_geneSum.empty() ? 0.0 : deviation / static_cast<double>(m_geneSum.size());
+
+    return s;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void ConvergenceTrace::record(const GenerationStats& stats)
+{
+    if(m_ring.empty())
+        return;
+
+    m_ring[m_next] = stats;
+    m_next = (m_next + 1) % m_ring.size();
+    m_size = std::min(m_size + 1, m_ring.size());
+}
+
+std::vector<GenerationStats> ConvergenceTrace::chronological() const
+{
+    std::vector<GenerationStats> out{};
+    out.reserve(m_size);
+
+    const std::size_t first{ (m_next + m_ring.size() - m_size) % std::max<std::size_t>(1, m_ring.size()) };
+    for(std::size_t k {0}; k < m_size; ++k)
+        out.push_back(m_ring[(first + k) % m_ring.size()]);
+
+    return out;
+}
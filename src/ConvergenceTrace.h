@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+// Per-generation statistics of a run (`trace_length` key), kept in a preallocated ring buffer and
+// exported with the results file.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+struct GenerationStats
+{
+    int    generation{};
+    double best{};
+    double mean{};
+    double worst{};
+    double diversity{};          // mean over the genes of the population standard deviation
+    double mutation_rate{};      // GA only
+    double mutation_strength{};  // GA; CMA-ES: step size sigma
+
+    // Coluna que não se aplica ao engine (DE nas duas, CMA-ES na taxa): vazia no csv, NaN no binário
+    static constexpr double notApplicable{ std::numeric_limits<double>::quiet_NaN() };
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Running sums over (a slice of) one generation, filled in while its fitness is evaluated.
+///
+/// Each worker accumulates its own slice; the slices are merged with += once the generation is done.
+class PopulationMoments
+{
+public:
+    void reset(std::size_t dimensions)
+    {
+        m_count = 0;
+        m_sum = 0.0;
+        m_min = std::numeric_limits<double>::infinity();
+        m_max = -std::numeric_limits<double>::infinity();
+        m_geneSum.assign(dimensions, 0.0);
+        m_geneSumSq.assign(dimensions, 0.0);
+    }
+
+    template <typename T>
+    void add(std::span<const T> genes, double fitness)
+    {
+        ++m_count;
+        m_sum += fitness;
+        m_min = std::min(m_min, fitness);
+        m_max = std::max(m_max, fitness);
+
+        const std::size_t n{ std::min(genes.size(), m_geneSum.size()) };
+
+        #pragma omp simd
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            const double g{ static_cast<double>(genes[j]) };
+            m_geneSum[j] += g;
+            m_geneSumSq[j] += g * g;
+        }
+    }
+
+    PopulationMoments& operator+=(const PopulationMoments& other);
+
+    GenerationStats stats(int generation, double mutationRate, double mutationStrength) const;
+
+private:
+    std::size_t         m_count{};
+    double              m_sum{};
+    double              m_min{};
+    double              m_max{};
+    std::vector<double> m_geneSum{};
+    std::vector<double> m_geneSumSq{};
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Fixed-capacity ring of the last `capacity` generations; recording never allocates.
+class ConvergenceTrace
+{
+public:
+    explicit ConvergenceTrace(int capacity) : m_ring(static_cast<std::size_t>(std::max(0, capacity))) {}
+
+    bool                         enabled() const { return !m_ring.empty(); }
+    void                         record(const GenerationStats& stats);
+
+    /// @brief The recorded generations, oldest first.
+    std::vector<GenerationStats> chronological() const;
+
+private:
+    std::vector<GenerationStats> m_ring;
+    std::size_t                  m_next{ 0 };
+    std::size_t                  m_size{ 0 };
+};
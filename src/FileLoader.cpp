@@ -8,7 +8,11 @@ std::unordered_map<std::string, TargetFunction> targetFunctionMap
     {"ackley", TargetFunction::ackley},
     {"sphere", TargetFunction::sphere},
     {"easom", TargetFunction::easom},
-    {"mccormick", TargetFunction::mccormick}
+    {"mccormick", TargetFunction::mccormick},
+    {"rosenbrock", TargetFunction::rosenbrock},
+    {"schwefel", TargetFunction::schwefel},
+    {"griewank", TargetFunction::griewank},
+    {"levy", TargetFunction::levy}
 };
 
 std::unordered_map<std::string, SelectionMethod> selectionMethodMap 
@@ -22,7 +26,102 @@ std::unordered_map<std::string, Points> pointsMap
 {
     {"one", Points::one},
     {"two", Points::two},
-    {"uniform", Points::uniform}
+    {"uniform", Points::uniform},
+    {"arithmetic", Points::arithmetic},
+    {"blx", Points::blx},
+    {"sbx", Points::sbx}
+};
+
+std::unordered_map<std::string, BoundaryHandling> boundaryHandlingMap
+{
+    {"clamp", BoundaryHandling::clamp},
+    {"reflect", BoundaryHandling::reflect},
+    {"wrap", BoundaryHandling::wrap},
+    {"random", BoundaryHandling::reinit}
+};
+
+std::unordered_map<std::string, Engine> engineMap
+{
+    {"ga", Engine::ga},
+    {"de_rand1bin", Engine::de_rand_1_bin},
+    {"de_best1bin", Engine::de_best_1_bin},
+    {"cmaes", Engine::cmaes},
+    {"nsga2", Engine::nsga2}
+};
+
+std::unordered_map<std::string, MutationSchedule> scheduleMap
+{
+    {"linear", MutationSchedule::linear},
+    {"exponential", MutationSchedule::exponential},
+    {"cosine", MutationSchedule::cosine},
+    {"adaptive", MutationSchedule::adaptive}
+};
+
+std::unordered_map<std::string, Precision> precisionMap
+{
+    {"double", Precision::float64},
+    {"float", Precision::float32},
+    {"mixed", Precision::mixed}
+};
+
+std::unordered_map<std::string, InitSampling> initSamplingMap
+{
+    {"uniform", InitSampling::uniform},
+    {"sobol", InitSampling::sobol},
+    {"halton", InitSampling::halton},
+    {"lhs", InitSampling::lhs}
+};
+
+std::unordered_map<std::string, TransportType> transportMap
+{
+    {"loopback", TransportType::loopback},
+    {"tcp", TransportType::tcp},
+    {"unix", TransportType::unix_socket}
+};
+
+std::unordered_map<std::string, ResultsFormat> resultsFormatMap
+{
+    {"csv", ResultsFormat::csv},
+    {"binary", ResultsFormat::binary}
+};
+
+std::unordered_map<std::string, ObjectiveFunction> objectiveFunctionMap
+{
+    {"zdt1", ObjectiveFunction::zdt1},
+    {"zdt2", ObjectiveFunction::zdt2},
+    {"zdt3", ObjectiveFunction::zdt3},
+    {"dtlz2", ObjectiveFunction::dtlz2}
+};
+
+std::unordered_map<std::string, SurrogateType> surrogateMap
+{
+    {"none", SurrogateType::none},
+    {"knn", SurrogateType::knn},
+    {"rbf", SurrogateType::rbf}
+};
+
+std::unordered_map<std::string, LocalSearch> localSearchMap
+{
+    {"none", LocalSearch::none},
+    {"coordinate", LocalSearch::coordinate},
+    {"nelder_mead", LocalSearch::nelder_mead},
+    {"lbfgs", LocalSearch::lbfgs}
+};
+
+std::unordered_map<std::string, Niching> nichingMap
+{
+    {"none", Niching::none},
+    {"sharing", Niching::sharing},
+    {"clearing", Niching::clearing},
+    {"crowding", Niching::crowding}
+};
+
+std::unordered_map<std::string, TransformType> transformMap
+{
+    {"none", TransformType::none},
+    {"shifted", TransformType::shifted},
+    {"rotated", TransformType::rotated},
+    {"shifted_rotated", TransformType::shifted_rotated}
 };
 
 std::string toLower(const std::string_view str) 
@@ -55,6 +154,78 @@ Points FileLoader::getPoints(const std::string_view str)
     return pointsMap[lowerStr];
 }
 
+BoundaryHandling FileLoader::getBoundaryHandling(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return boundaryHandlingMap[lowerStr];
+}
+
+Engine FileLoader::getEngine(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return engineMap[lowerStr];
+}
+
+MutationSchedule FileLoader::getSchedule(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return scheduleMap[lowerStr];
+}
+
+Precision FileLoader::getPrecision(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return precisionMap[lowerStr];
+}
+
+InitSampling FileLoader::getInitSampling(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return initSamplingMap[lowerStr];
+}
+
+TransportType FileLoader::getTransport(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return transportMap[lowerStr];
+}
+
+ResultsFormat FileLoader::getResultsFormat(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return resultsFormatMap[lowerStr];
+}
+
+ObjectiveFunction FileLoader::getObjectiveFunction(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return objectiveFunctionMap[lowerStr];
+}
+
+SurrogateType FileLoader::getSurrogate(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return surrogateMap[lowerStr];
+}
+
+LocalSearch FileLoader::getLocalSearch(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return localSearchMap[lowerStr];
+}
+
+Niching FileLoader::getNiching(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return nichingMap[lowerStr];
+}
+
+TransformType FileLoader::getTransform(const std::string_view str)
+{
+    std::string lowerStr{ toLower(str) };
+    return transformMap[lowerStr];
+}
+
 Parameters FileLoader::loadFromTXT(const std::string& filePath) 
 {
     Parameters params{};
@@ -102,19 +273,119 @@ Parameters FileLoader::loadFromTXT(const std::string& filePath)
                         params.print_precision = std::stoi(value);
                     else if (lowerKey == "num_tests") 
                         params.num_tests = std::stoi(value);
+                    else if (lowerKey == "fitness_cache_size")
+                        params.fitness_cache_size = std::stoi(value);
+                    else if (lowerKey == "boundary_handling")
+                        params.boundary_handling = getBoundaryHandling(value);
+                    else if (lowerKey == "engine")
+                        params.engine = getEngine(value);
+                    else if (lowerKey == "differential_weight")
+                        params.differential_weight = std::stod(value);
+                    else if (lowerKey == "crossover_rate")
+                        params.crossover_rate = std::stod(value);
+                    else if (lowerKey == "cma_lambda")
+                        params.cma_lambda = std::stoi(value);
+                    else if (lowerKey == "schedule")
+                        params.schedule = getSchedule(value);
+                    else if (lowerKey == "precision")
+                        params.precision = getPrecision(value);
+                    else if (lowerKey == "polish_evaluations")
+                        params.polish_evaluations = std::stoi(value);
+                    else if (lowerKey == "initialization")
+                        params.init_sampling = getInitSampling(value);
+                    else if (lowerKey == "large_population")
+                        params.large_population = std::stoi(value) != 0;
+                    else if (lowerKey == "memory_budget_mb")
+                        params.memory_budget_mb = std::stoi(value);
+                    else if (lowerKey == "out_of_core")
+                        params.out_of_core = std::stoi(value) != 0;
+                    else if (lowerKey == "tile_directory")
+                        params.tile_directory = value;
+                    else if (lowerKey == "islands")
+                        params.islands = std::stoi(value);
+                    else if (lowerKey == "island_rank")
+                        params.island_rank = std::stoi(value);
+                    else if (lowerKey == "transport")
+                        params.transport = getTransport(value);
+                    else if (lowerKey == "coordinator_address")
+                        params.coordinator_address = value;
+                    else if (lowerKey == "migration_interval")
+                        params.migration_interval = std::stoi(value);
+                    else if (lowerKey == "migration_size")
+                        params.migration_size = std::stoi(value);
+                    else if (lowerKey == "results_file")
+                        params.results_file = value;
+                    else if (lowerKey == "results_format")
+                        params.results_format = getResultsFormat(value);
+                    else if (lowerKey == "trace_length")
+                        params.trace_length = std::stoi(value);
+                    else if (lowerKey == "threads_per_test")
+                        params.threads_per_test = std::stoi(value);
+                    else if (lowerKey == "parallel_chunk")
+                        params.parallel_chunk = std::stoi(value);
+                    else if (lowerKey == "objective_function")
+                        params.objective_function = getObjectiveFunction(value);
+                    else if (lowerKey == "objectives")
+                        params.objectives = std::stoi(value);
+                    else if (lowerKey == "pareto_file")
+                        params.pareto_file = value;
+                    else if (lowerKey == "surrogate")
+                        params.surrogate = getSurrogate(value);
+                    else if (lowerKey == "surrogate_fraction")
+                        params.surrogate_fraction = std::stod(value);
+                    else if (lowerKey == "surrogate_archive")
+                        params.surrogate_archive = std::stoi(value);
+                    else if (lowerKey == "surrogate_neighbors")
+                        params.surrogate_neighbors = std::stoi(value);
+                    else if (lowerKey == "local_search")
+                        params.local_search = getLocalSearch(value);
+                    else if (lowerKey == "local_search_interval")
+                        params.local_search_interval = std::stoi(value);
+                    else if (lowerKey == "local_search_elites")
+                        params.local_search_elites = std::stoi(value);
+                    else if (lowerKey == "local_search_evaluations")
+                        params.local_search_evaluations = std::stoi(value);
+                    else if (lowerKey == "niching")
+                        params.niching = getNiching(value);
+                    else if (lowerKey == "niche_radius")
+                        params.niche_radius = std::stod(value);
+                    else if (lowerKey == "niche_capacity")
+                        params.niche_capacity = std::stoi(value);
+                    else if (lowerKey == "seed")
+                        params.seed = std::stoull(value);
+                    else if (lowerKey == "transform")
+                        params.transform = getTransform(value);
+                    else if (lowerKey == "transform_seed")
+                        params.transform_seed = std::stoull(value);
+                    else if (lowerKey == "perf_counters")
+                        params.perf_counters = std::stoi(value) != 0;
+                    else if (lowerKey == "tournament_size")
+                        params.tournament_size = std::stoi(value);
+                    else if (lowerKey == "blx_alpha")
+                        params.blx_alpha = std::stod(value);
+                    else if (lowerKey == "sbx_eta")
+                        params.sbx_eta = std::stod(value);
+                    else if (lowerKey == "stop_fitness")
+                    {
+                        params.stop_fitness = std::stod(value);
+                        params.stop_at_fitness = true;
+                    }
                 }
             }
         }
         file.close();
-        params.mutation_rate = params.initial_mutation_rate;
-        params.mutation_strength = params.initial_mutation_strength;
+
+        // Modo fora da memória é uma variante do modo de populações enormes
+        if(params.out_of_core)
+        {
+            params.large_population = true;
+            if(params.tile_directory.empty())
+                params.tile_directory = std::filesystem::temp_directory_path().string();
+        }
     } 
 
     else 
-    {
-        std::cerr << "Unable to open file: " << filePath << std::endl;
-        exit(EXIT_FAILURE);
-    }
+        throw std::runtime_error("Unable to open file: " + filePath);
     
     return params;
 }
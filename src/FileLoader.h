@@ -8,16 +8,31 @@
 #include <unordered_map>
 #include <algorithm>
 #include <cctype>
+#include <filesystem>
+#include <stdexcept>
 #include "Parameters.h"
 
 class FileLoader 
 {
 public:
+    /// @brief Throws std::runtime_error if the file cannot be opened and std::invalid_argument for a malformed number.
     static Parameters      loadFromTXT(const std::string& filePath);
 
 private:
     static TargetFunction  getTargetFunction(const std::string_view str);
     static SelectionMethod getSelectionMethod(const std::string_view str);
     static Points          getPoints(const std::string_view str);
+    static BoundaryHandling getBoundaryHandling(const std::string_view str);
+    static Engine          getEngine(const std::string_view str);
+    static MutationSchedule getSchedule(const std::string_view str);
+    static Precision       getPrecision(const std::string_view str);
+    static InitSampling    getInitSampling(const std::string_view str);
+    static TransportType   getTransport(const std::string_view str);
+    static ResultsFormat   getResultsFormat(const std::string_view str);
+    static ObjectiveFunction getObjectiveFunction(const std::string_view str);
+    static SurrogateType   getSurrogate(const std::string_view str);
+    static LocalSearch     getLocalSearch(const std::string_view str);
+    static Niching         getNiching(const std::string_view str);
+    static TransformType   getTransform(const std::string_view str);
         
 };
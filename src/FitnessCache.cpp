@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include "FitnessCache.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+FitnessCache::FitnessCache(std::size_t capacity, std::size_t numShards)
+    : m_shards(std::max<std::size_t>(1, numShards)), 
+      m_shardCapacity{ std::max<std::size_t>(1, capacity / std::max<std::size_t>(1, numShards)) },
+      m_capacity{ m_shardCapacity * m_shards.size() }
+    {
+        for(auto& shard : m_shards)
+        {
+            shard.slots.reserve(m_shardCapacity);
+            shard.index.reserve(m_shardCapacity);
+        }
+    }
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+bool FitnessCache::lookup(const Key& key, double& fitness)
+{
+    Shard& shard{ shardFor(key) };
+    std::lock_guard lock{ shard.mtx };
+
+    auto it{ shard.index.find(key.hash) };
+
+    // Mesmo hash de vaga com outro hash de conferência: outros genes, conta como falta
+    if(it == shard.index.end() || shard.slots[it->second].check != key.check)
+    {
+        ++shard.stats.misses;
+        return false;
+    }
+
+    Slot& slot{ shard.slots[it->second] };
+    slot.referenced = true;
+    fitness = slot.fitness;
+    ++shard.stats.hits;
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void FitnessCache::insert(const Key& key, double fitness)
+{
+    Shard& shard{ shardFor(key) };
+    std::lock_guard lock{ shard.mtx };
+
+    // Colisão do hash de vaga: o genoma mais recente fica com ela
+    if(const auto it{ shard.index.find(key.hash) }; it != shard.index.end())
+    {
+        Slot& slot{ shard.slots[it->second] };
+        if(slot.check != key.check)
+            slot = { key.hash, key.check, fitness, false };
+        return;
+    }
+
+    if(shard.slots.size() < m_shardCapacity)
+    {
+        shard.index.emplace(key.hash, shard.slots.size());
+        shard.slots.push_back({ key.hash, key.check, fitness, false });
+        return;
+    }
+
+    // CLOCK: gives every referenced slot a second chance before evicting it
+    while(shard.slots[shard.hand].referenced)
+    {
+        shard.slots[shard.hand].referenced = false;
+        shard.hand = (shard.hand + 1) % m_shardCapacity;
+    }
+
+    Slot& victim{ shard.slots[shard.hand] };
+    shard.index.erase(victim.key);
+    shard.index.emplace(key.hash, shard.hand);
+    victim = { key.hash, key.check, fitness, false };
+    shard.hand = (shard.hand + 1) % m_shardCapacity;
+    ++shard.stats.evictions;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+CacheStats FitnessCache::stats() const
+{
+    CacheStats total{};
+
+    for(const auto& shard : m_shards)
+    {
+        std::lock_guard lock{ shard.mtx };
+        total += shard.stats;
+    }
+
+    return total;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Both hashes of the raw gene bytes (float or double genes alike), in one pass.
+FitnessCache::Key FitnessCache::key(const void* genes, std::size_t bytes)
+{
+    // Vaga: FNV-1a sobre palavras de 64 bits com o finalizador do splitmix64.
+    // Conferência: multiplicação e rotação com outra semente e o finalizador do murmur3
+    const auto* data{ static_cast<const unsigned char*>(genes) };
+    std::uint64_t h{ 0xcbf29ce484222325ULL };
+    std::uint64_t c{ 0x9e3779b97f4a7c15ULL ^ bytes };
+
+    const auto mix{ [&h, &c](std::uint64_t word) {
+        h ^= word;
+        h *= 0x100000001b3ULL;
+        c = std::rotl(c ^ word, 29) * 0xff51afd7ed558ccdULL;
+    } };
+
+    std::size_t offset{ 0 };
+    for(; offset + sizeof(std::uint64_t) <= bytes; offset += sizeof(std::uint64_t))
+    {
+        std::uint64_t word{};
+        std::memcpy(&word, data + offset, sizeof(word));
+        mix(word);
+    }
+
+    for(; offset < bytes; ++offset)
+        mix(data[offset]);
+
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+
+    c ^= c >> 33;
+    c *= 0xff51afd7ed558ccdULL;
+    c ^= c >> 33;
+    c *= 0xc4ceb9fe1a85ec53ULL;
+    c ^= c >> 33;
+
+    return { h, c };
+}
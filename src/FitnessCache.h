@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+struct CacheStats
+{
+   std::uint64_t hits{};
+   std::uint64_t misses{};
+   std::uint64_t evictions{};
+
+   double hitRate() const
+   {
+      const auto total{ hits + misses };
+      return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+   }
+
+   CacheStats& operator+=(const CacheStats& other)
+   {
+      hits += other.hits;
+      misses += other.misses;
+      evictions += other.evictions;
+      return *this;
+   }
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Bounded fitness memoization keyed on a hash of the raw gene bits.
+///
+/// The table is split into independently locked shards so parallel workers rarely contend.
+/// Each shard evicts with the CLOCK (second chance) policy once it is full. Every slot also keeps a
+/// second, independent hash of the genes; a hit counts only when it matches too, so two genomes whose
+/// slot hashes collide do not share a fitness.
+class FitnessCache
+{
+public:
+    /// @brief `hash` picks the slot, `check` confirms that the slot holds the same genes.
+    struct Key
+    {
+        std::uint64_t hash{};
+        std::uint64_t check{};
+    };
+
+    explicit FitnessCache(std::size_t capacity, std::size_t numShards = 16);
+
+    bool                 lookup(const Key& key, double& fitness);
+    void                 insert(const Key& key, double fitness);
+    CacheStats           stats() const;
+    std::size_t          capacity() const { return m_capacity; }
+
+    static Key           key(const void* genes, std::size_t bytes);
+
+private:
+    struct Slot
+    {
+        std::uint64_t key{};
+        std::uint64_t check{};
+        double        fitness{};
+        bool          referenced{};
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable std::mutex                         mtx{};
+        std::vector<Slot>                          slots{};
+        std::unordered_map<std::uint64_t, std::size_t> index{};
+        std::size_t                                hand{};
+        CacheStats                                 stats{};
+    };
+
+    Shard& shardFor(const Key& key) { return m_shards[(key.hash >> 48) % m_shards.size()]; }
+
+    std::vector<Shard> m_shards;
+    std::size_t        m_shardCapacity;
+    std::size_t        m_capacity;
+};
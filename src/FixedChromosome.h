@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Genome whose dimension is a compile-time constant. The genes live inline in the individual, so a
+// population is one contiguous array with no allocation per individual, and every per-gene loop (mutation,
+// bounds, crossover kernels, benchmark functions) has a constant trip count the compiler unrolls.
+// Used by fixedGenomeGA when `dimensions` is one of fixedChromosomeSizes.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, std::size_t D>
+struct FixedChromosome
+{
+    using value_type = T;
+    static constexpr std::size_t dimensions{ D };
+
+    std::array<T, D> genes{};
+    double           fitness{};
+
+    std::span<const T, D> view() const { return genes; }
+    double get_fitness() const { return fitness; }
+
+    bool operator<(const FixedChromosome& other) const { return fitness < other.fitness; }
+};
+
+template <typename T, std::size_t D>
+using FixedPopulation = std::vector<FixedChromosome<T, D>>;
+
+// Tamanhos com versão compilada; as demais dimensões usam BasicChromosome
+inline constexpr std::array<std::size_t, 9> fixedChromosomeSizes{ 2, 3, 4, 5, 6, 8, 10, 12, 16 };
+
+constexpr bool hasFixedChromosome(std::size_t dimensions)
+{
+    return std::find(fixedChromosomeSizes.begin(), fixedChromosomeSizes.end(), dimensions) != fixedChromosomeSizes.end();
+}
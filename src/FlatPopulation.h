@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Parameters.h"
+#include "mapped_tiles.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Population stored as flat gene rows, split into fixed-size tiles, plus a contiguous fitness array.
+///
+/// Used by the large-population mode instead of Population<T>: no per-individual heap allocation,
+/// and tiles are left untouched until the thread that fills them first writes to them.
+/// Given a tile directory the genes live in a memory-mapped file instead (out-of-core mode) and
+/// only the fitness array is guaranteed to stay resident.
+template <typename T>
+class FlatPopulation
+{
+public:
+    static constexpr std::size_t chunkSize{ std::size_t{ 1 } << 16 }; // individuals per tile
+
+    FlatPopulation(std::size_t size, std::size_t dimensions, const std::string& tileDirectory = "")
+        : m_size{ size }, m_dimensions{ dimensions }, m_fitness{ std::make_unique_for_overwrite<double[]>(size) }
+    {
+        if(!tileDirectory.empty())
+            m_mapping = mapScratchFile(tileDirectory, std::max<std::size_t>(1, size * dimensions * sizeof(T)));
+
+        for(std::size_t first {0}; first < size; first += chunkSize)
+        {
+            if(m_mapping)
+                m_chunks.push_back(reinterpret_cast<T*>(m_mapping.get()) + first * dimensions);
+            else
+                m_chunks.push_back(m_owned.emplace_back(std::make_unique_for_overwrite<T[]>(std::min(chunkSize, size - first) * dimensions)).get());
+        }
+    }
+
+    T*              genes(std::size_t i)       { return m_chunks[i / chunkSize] + (i % chunkSize) * m_dimensions; }
+    const T*        genes(std::size_t i) const { return m_chunks[i / chunkSize] + (i % chunkSize) * m_dimensions; }
+    double&         fitness(std::size_t i)       { return m_fitness[i]; }
+    double          fitness(std::size_t i) const { return m_fitness[i]; }
+    const double*   fitness_array() const { return m_fitness.get(); }
+
+    std::size_t     size() const { return m_size; }
+    std::size_t     dimensions() const { return m_dimensions; }
+    std::size_t     numChunks() const { return m_chunks.size(); }
+    bool            mapped() const { return static_cast<bool>(m_mapping); }
+
+    // Out-of-core hints; no-ops for a population kept in RAM
+    void            prefetch(std::size_t chunk) const { if(m_mapping && chunk < m_chunks.size()) prefetchRange(m_chunks[chunk], chunkBytes(chunk)); }
+    void            flush(std::size_t chunk) const { if(m_mapping) flushRange(m_chunks[chunk], chunkBytes(chunk)); }
+
+private:
+    std::size_t chunkBytes(std::size_t chunk) const { return std::min(chunkSize, m_size - chunk * chunkSize) * m_dimensions * sizeof(T); }
+
+    std::size_t                       m_size;
+    std::size_t                       m_dimensions;
+    std::vector<T*>                   m_chunks{};
+    std::vector<std::unique_ptr<T[]>> m_owned{};
+    MappedRegion                      m_mapping{ nullptr, MappingDeleter{} };
+    std::unique_ptr<double[]>         m_fitness;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Estimated resident memory of one large-population run, by component.
+struct MemoryBudget
+{
+    std::size_t genes{};   // resident only when the population is kept in RAM
+    std::size_t mapped{};  // out-of-core gene tiles, on disk
+    std::size_t fitness{};
+    std::size_t sort{};
+    std::size_t cdf{};
+    std::size_t batches{};
+    std::size_t cache{};
+
+    std::size_t total() const { return genes + fitness + sort + cdf + batches + cache; }
+
+    static MemoryBudget estimate(const Parameters& p, int numThreads);
+};
+
+void printMemoryBudget(const Parameters& p, int numThreads);
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include "Random.h"
+#include "FunctionTransform.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    // Blocos do produto de matrizes: rowBlock genomas passam por cada ladrilho depthBlock x columnBlock de Mᵀ
+    // (128 KB em double) enquanto ele está no cache
+    constexpr std::size_t rowBlock{ 64 };
+    constexpr std::size_t depthBlock{ 64 };
+    constexpr std::size_t columnBlock{ 256 };
+
+    // Micro-kernel: microRows genomas x microColumns saídas acumulados em registradores ao longo do ladrilho
+    constexpr std::size_t microRows{ 4 };
+    constexpr std::size_t microColumns{ 8 };
+
+    // Genomas empacotados por vez em evaluateBlock, para o buffer não crescer com a população
+    constexpr std::size_t packedRows{ 256 };
+
+    std::unique_ptr<const FunctionTransform> installed{};
+
+    /// @brief z[r][c] += sum over k in [k0, k1) of x[r][k] Mᵀ[k][c], for R rows and c in [c0, c1).
+    ///
+    /// Every element adds its terms in increasing k whatever R is, so the result does not depend on how
+    /// the genomes were grouped.
+    template <std::size_t R, typename T>
+    void rotateRows(const T* x, T* z, const T* rotation, std::size_t n, std::size_t k0, std::size_t k1, std::size_t c0, std::size_t c1)
+    {
+        std::size_t c{ c0 };
+        for(; c + microColumns <= c1; c += microColumns)
+        {
+            T acc[R][microColumns];
+            for(std::size_t i {0}; i < R; ++i)
+                for(std::size_t j {0}; j < microColumns; ++j)
+                    acc[i][j] = z[i * n + c + j];
+
+            for(std::size_t k {k0}; k < k1; ++k)
+            {
+                const T* column{ rotation + k * n + c };
+                for(std::size_t i {0}; i < R; ++i)
+                {
+                    const T xk{ x[i * n + k] };
+                    for(std::size_t j {0}; j < microColumns; ++j)
+                        acc[i][j] += xk * column[j];
+                }
+            }
+
+            for(std::size_t i {0}; i < R; ++i)
+                for(std::size_t j {0}; j < microColumns; ++j)
+                    z[i * n + c + j] = acc[i][j];
+        }
+
+        for(; c < c1; ++c)
+        {
+            for(std::size_t i {0}; i < R; ++i)
+            {
+                T acc{ z[i * n + c] };
+                for(std::size_t k {k0}; k < k1; ++k)
+                    acc += x[i * n + k] * rotation[k * n + c];
+                z[i * n + c] = acc;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    double transformedObjective(std::span<const T> genes)
+    {
+        return installed->evaluate(genes);
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+FunctionTransform::FunctionTransform(TargetFunction fnc, std::size_t dimensions, const std::vector<double>& lower, const std::vector<double>& upper,
+                                     TransformType type, std::uint64_t seed)
+    : m_function{ fnc }, m_dimensions{ dimensions }
+{
+    const bool shift{ type == TransformType::shifted || type == TransformType::shifted_rotated };
+    const bool rotate{ type == TransformType::rotated || type == TransformType::shifted_rotated };
+    const std::size_t n{ dimensions };
+
+    // Gerador próprio: o problema depende só de transform_seed, não da semente das execuções
+    std::mt19937 engine{ Random::stream(seed, 0) };
+    std::uniform_real_distribution<double> uniform{ 0.1, 0.9 };
+
+    m_dataD.optimum.resize(n);
+    m_dataD.shift.resize(n);
+    for(std::size_t j {0}; j < n; ++j)
+    {
+        m_dataD.optimum[j] = Benchmark::optimum(fnc, j);
+        m_dataD.shift[j]   = shift ? lower[j] + uniform(engine) * (upper[j] - lower[j]) : m_dataD.optimum[j];
+    }
+
+    if(rotate)
+    {
+        // Matriz gaussiana ortonormalizada por Gram-Schmidt modificado: rotação uniforme sobre O(n)
+        std::normal_distribution<double> normal{ 0.0, 1.0 };
+        std::vector<double> m(n * n);
+        for(double& value : m)
+            value = normal(engine);
+
+        for(std::size_t k {0}; k < n; ++k)
+        {
+            double* pivot{ m.data() + k * n };
+            double norm{ 0.0 };
+            for(std::size_t j {0}; j < n; ++j)
+                norm += pivot[j] * pivot[j];
+            norm = std::sqrt(norm);
+            for(std::size_t j {0}; j < n; ++j)
+                pivot[j] /= norm;
+
+            #pragma omp parallel for schedule(static) if(n - k > 256)
+            for(std::size_t i = k + 1; i < n; ++i)
+            {
+                double* row{ m.data() + i * n };
+                double dot{ 0.0 };
+                for(std::size_t j {0}; j < n; ++j)
+                    dot += row[j] * pivot[j];
+                for(std::size_t j {0}; j < n; ++j)
+                    row[j] -= dot * pivot[j];
+            }
+        }
+
+        // Guardada transposta: o kernel percorre linhas contíguas de Mᵀ
+        m_dataD.rotation.resize(n * n);
+        for(std::size_t i {0}; i < n; ++i)
+            for(std::size_t j {0}; j < n; ++j)
+                m_dataD.rotation[j * n + i] = m[i * n + j];
+    }
+
+    m_dataF.shift.assign(m_dataD.shift.begin(), m_dataD.shift.end());
+    m_dataF.optimum.assign(m_dataD.optimum.begin(), m_dataD.optimum.end());
+    m_dataF.rotation.assign(m_dataD.rotation.begin(), m_dataD.rotation.end());
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void FunctionTransform::rotate(const T* shifted, T* z, std::size_t rows) const
+{
+    const std::size_t n{ m_dimensions };
+    const Data<T>& d{ data<T>() };
+
+    for(std::size_t r {0}; r < rows; ++r)
+        std::copy(d.optimum.begin(), d.optimum.end(), z + r * n);
+
+    // Z += X Mᵀ em ladrilhos; cada elemento soma as coordenadas em ordem crescente, com ou sem bloco,
+    // então um genoma avaliado sozinho ou dentro de um bloco recebe exatamente o mesmo fitness
+    for(std::size_t r0 {0}; r0 < rows; r0 += rowBlock)
+    {
+        const std::size_t r1{ std::min(rows, r0 + rowBlock) };
+
+        for(std::size_t k0 {0}; k0 < n; k0 += depthBlock)
+        {
+            const std::size_t k1{ std::min(n, k0 + depthBlock) };
+
+            for(std::size_t c0 {0}; c0 < n; c0 += columnBlock)
+            {
+                const std::size_t c1{ std::min(n, c0 + columnBlock) };
+
+                std::size_t r{ r0 };
+                for(; r + microRows <= r1; r += microRows)
+                    rotateRows<microRows>(shifted + r * n, z + r * n, d.rotation.data(), n, k0, k1, c0, c1);
+                for(; r < r1; ++r)
+                    rotateRows<1>(shifted + r * n, z + r * n, d.rotation.data(), n, k0, k1, c0, c1);
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+double FunctionTransform::evaluate(std::span<const T> genes) const
+{
+    const auto base{ Benchmark::function<T>(m_function) };
+    const std::size_t n{ m_dimensions };
+
+    if(genes.size() != n)
+        return base(genes);
+
+    const Data<T>& d{ data<T>() };
+    thread_local std::vector<T> shifted{};
+    thread_local std::vector<T> z{};
+    shifted.resize(n);
+    z.resize(n);
+
+    for(std::size_t j {0}; j < n; ++j)
+        shifted[j] = genes[j] - d.shift[j];
+
+    if(!rotated())
+    {
+        for(std::size_t j {0}; j < n; ++j)
+            z[j] = shifted[j] + d.optimum[j];
+    }
+    else
+        rotate(shifted.data(), z.data(), 1);
+
+    return base(std::span<const T>(z));
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void FunctionTransform::evaluateBlock(std::span<const T* const> genomes, std::span<double> fitness) const
+{
+    if(!rotated())
+    {
+        for(std::size_t r {0}; r < genomes.size(); ++r)
+            fitness[r] = evaluate(std::span<const T>(genomes[r], m_dimensions));
+        return;
+    }
+
+    const auto base{ Benchmark::function<T>(m_function) };
+    const std::size_t n{ m_dimensions };
+    const Data<T>& d{ data<T>() };
+
+    thread_local std::vector<T> shifted{};
+    thread_local std::vector<T> z{};
+
+    for(std::size_t first {0}; first < genomes.size(); first += packedRows)
+    {
+        const std::size_t rows{ std::min(packedRows, genomes.size() - first) };
+        shifted.resize(rows * n);
+        z.resize(rows * n);
+
+        for(std::size_t r {0}; r < rows; ++r)
+        {
+            const T* genes{ genomes[first + r] };
+            T* row{ shifted.data() + r * n };
+
+            #pragma omp simd
+            for(std::size_t j = 0; j < n; ++j)
+                row[j] = genes[j] - d.shift[j];
+        }
+
+        rotate(shifted.data(), z.data(), rows);
+
+        for(std::size_t r {0}; r < rows; ++r)
+            fitness[first + r] = base(std::span<const T>(z.data() + r * n, n));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void FunctionTransform::install(const FunctionTransform& transform)
+{
+    installed = std::make_unique<const FunctionTransform>(transform);
+}
+
+const FunctionTransform* FunctionTransform::active(TargetFunction fnc)
+{
+    return installed && installed->m_function == fnc ? installed.get() : nullptr;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+Benchmark::FncPtr<T> Benchmark::objective(TargetFunction fnc)
+{
+    return FunctionTransform::active(fnc) ? transformedObjective<T> : function<T>(fnc);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template double FunctionTransform::evaluate<float>(std::span<const float>) const;
+template double FunctionTransform::evaluate<double>(std::span<const double>) const;
+template void FunctionTransform::evaluateBlock<float>(std::span<const float* const>, std::span<double>) const;
+template void FunctionTransform::evaluateBlock<double>(std::span<const double* const>, std::span<double>) const;
+template Benchmark::FncPtr<float> Benchmark::objective<float>(TargetFunction);
+template Benchmark::FncPtr<double> Benchmark::objective<double>(TargetFunction);
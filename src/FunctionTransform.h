@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "constants.h"
+#include "functions.hpp"
+
+// Shifted and rotated benchmark variants in the style of the CEC suites (`transform` key). The objective
+// becomes f(M (x - o) + x*): o is a point drawn inside the search box, M a random orthogonal matrix and x*
+// the optimum of the base function, so the global minimum moves to o and no coordinate can be optimised on
+// its own. Shift and rotation are generated from `transform_seed` only, so every run, test and island sees
+// the same problem.
+//
+// Rotating one individual is a D x D matrix-vector product. Blocks of the population are rotated as a single
+// matrix-matrix product instead, tiled so that each tile of the matrix stays in cache while every row of the
+// block goes through it; at D = 100-1000 that is what keeps rotated evaluation from being memory bound.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+class FunctionTransform
+{
+public:
+    FunctionTransform(TargetFunction fnc, std::size_t dimensions, const std::vector<double>& lower, const std::vector<double>& upper,
+                      TransformType type, std::uint64_t seed);
+
+    TargetFunction function() const { return m_function; }
+    std::size_t    dimensions() const { return m_dimensions; }
+    bool           rotated() const { return !m_dataD.rotation.empty(); }
+
+    /// @brief Transformed objective of one genome.
+    template <typename T>
+    double evaluate(std::span<const T> genes) const;
+
+    /// @brief Transformed objective of `genomes.size()` genomes of dimensions() genes each, rotated together.
+    template <typename T>
+    void evaluateBlock(std::span<const T* const> genomes, std::span<double> fitness) const;
+
+    /// @brief Makes `transform` the one every evaluation of its function goes through. Call before any run starts.
+    static void install(const FunctionTransform& transform);
+    /// @return the installed transform when it applies to `fnc`, otherwise nullptr
+    static const FunctionTransform* active(TargetFunction fnc);
+
+private:
+    template <typename T>
+    struct Data
+    {
+        std::vector<T> shift{};       // o
+        std::vector<T> optimum{};     // x*
+        std::vector<T> rotation{};    // Mᵀ, linha k com a contribuição da coordenada k para cada saída
+    };
+
+    template <typename T>
+    const Data<T>& data() const
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return m_dataF;
+        else
+            return m_dataD;
+    }
+
+    /// @brief z = M (x - o) + x* for `rows` row-major genomes, given x - o.
+    template <typename T>
+    void rotate(const T* shifted, T* z, std::size_t rows) const;
+
+    TargetFunction      m_function{};
+    std::size_t         m_dimensions{};
+    Data<double>        m_dataD{};
+    Data<float>         m_dataF{};
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace Benchmark {
+
+    /// @brief Objective actually optimised for `fnc`: the base function, or its installed shifted/rotated variant.
+    template <typename T>
+    FncPtr<T> objective(TargetFunction fnc);
+
+}
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <cmath>
+#include "MutationSchedule.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Value of a decaying parameter at `generation`, computed from the generation index alone.
+/// @return initial at generation 0, approaching final at nIterations
+double scheduledValue(MutationSchedule schedule, double initial, double final, int generation, int nIterations)
+{
+    const double t{ nIterations > 0 ? static_cast<double>(generation) / nIterations : 0.0 };
+
+    switch(schedule)
+    {
+        case MutationSchedule::exponential:
+            if(initial > 0.0 && final > 0.0)
+                return initial * std::pow(final / initial, t);
+            break;
+
+        case MutationSchedule::cosine:
+            return final + 0.5 * (initial - final) * (1.0 + std::cos(Constants::Math::pi * t));
+
+        default:
+            break;
+    }
+
+    return initial - t * (initial - final);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Sets the mutation rate and strength of the current generation.
+///
+/// The adaptive schedule applies Rechenberg's 1/5 success rule to the strength, using the
+/// success counters left by the previous generation; the rate still decays linearly.
+void updateMutationSchedule(const Parameters& p, RunState& state)
+{
+    if(p.schedule != MutationSchedule::adaptive)
+    {
+        state.mutation_rate = scheduledValue(p.schedule, p.initial_mutation_rate, p.final_mutation_rate, state.generation, p.nIterations);
+        state.mutation_strength = scheduledValue(p.schedule, p.initial_mutation_strength, p.final_mutation_strength, state.generation, p.nIterations);
+        return;
+    }
+
+    constexpr double factor{ 0.85 };
+    constexpr double targetRatio{ 0.2 };
+
+    state.mutation_rate = scheduledValue(MutationSchedule::linear, p.initial_mutation_rate, p.final_mutation_rate, state.generation, p.nIterations);
+
+    if(state.generation == 0)
+        state.mutation_strength = p.initial_mutation_strength;
+    else if(state.mutation_attempts > 0)
+    {
+        const double ratio{ static_cast<double>(state.mutation_successes) / state.mutation_attempts };
+
+        if(ratio > targetRatio)
+            state.mutation_strength /= factor;
+        else if(ratio < targetRatio)
+            state.mutation_strength *= factor;
+
+        const auto [low, high]{ std::minmax(p.initial_mutation_strength, p.final_mutation_strength) };
+        state.mutation_strength = std::clamp(state.mutation_strength, low, high);
+    }
+
+    state.mutation_attempts = 0;
+    state.mutation_successes = 0;
+}
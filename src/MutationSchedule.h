@@ -0,0 +1,7 @@
+#pragma once
+
+#include "Parameters.h"
+#include "RunState.h"
+
+double scheduledValue(MutationSchedule schedule, double initial, double final, int generation, int nIterations);
+void   updateMutationSchedule(const Parameters& p, RunState& state);
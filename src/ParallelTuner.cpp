@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <omp.h>
+#include "ParallelTuner.h"
+#include "engines.h"
+#include "genetic_operators.h"
+#include "multi_objective.h"
+#include "SearchBounds.h"
+#include "Timer.h"
+#include "Utils.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    // Calibração curta: cada medida roda até atingir este tempo ou o número máximo de gerações
+    constexpr double measureSeconds{ 0.02 };
+    constexpr int    maxMeasuredGenerations{ 8 };
+
+    // Teto da calibração inteira: uma fração das avaliações que os testes vão fazer e um tempo de relógio
+    constexpr double calibrationShare{ 0.02 };
+    constexpr double maxCalibrationSeconds{ 0.25 };
+    constexpr std::size_t evaluationPiece{ 16 };
+
+    // Um pedaço de trabalho paralelo deve custar ao menos isto, para diluir o custo de escalonamento
+    constexpr double minChunkSeconds{ 50e-6 };
+
+    /// @brief Thread counts worth measuring: powers of two up to maxThreads, and maxThreads itself.
+    std::vector<int> candidateThreads(int maxThreads)
+    {
+        std::vector<int> candidates{};
+        for(int t {1}; t < maxThreads; t *= 2)
+            candidates.push_back(t);
+        candidates.push_back(maxThreads);
+
+        return candidates;
+    }
+
+    /// @brief Evaluations the whole calibration may spend: calibrationShare of what the tests will evaluate
+    /// (every generation evaluates about two rows per child: the child and its mutated copy).
+    double evaluationBudget(const Parameters& p)
+    {
+        const double runEvaluations{ 2.0 * std::max(1, p.num_tests) * std::max(1, p.pop_size) * (std::max(0, p.nIterations) + 1.0) };
+        return std::max(static_cast<double>(evaluationPiece), calibrationShare * runEvaluations);
+    }
+
+    /// @brief Average time of one fitness evaluation, over a freshly initialized sample evaluated in pieces
+    /// until measureSeconds / 4 or the evaluation budget runs out.
+    double measureEvaluation(const Parameters& p, const SearchBounds& bounds, double budget)
+    {
+        const double limit{ std::min(budget, 64.0 * std::clamp(p.pop_size, 64, 4096)) };
+        const int sampleSize{ static_cast<int>(std::min(limit, static_cast<double>(std::clamp(p.pop_size, 64, 4096)))) };
+        double evaluated{ 0.0 };
+
+        if(p.engine == Engine::nsga2)
+        {
+            const SearchBounds box{ objectiveBounds(p) };
+            const std::size_t m{ objectiveCount(p) };
+            const Population<double> sample{ initialization<double>(box, sampleSize) };
+            std::vector<double> out(m);
+
+            Timer timer;
+            for(std::size_t i {0}; evaluated < limit; i = (i + 1) % sample.size())
+            {
+                evaluateObjectives(p.objective_function, sample[i].get_genes_array().data(), sample[i].size(), out.data(), m);
+                evaluated += 1.0;
+
+                if(i % evaluationPiece == evaluationPiece - 1 && timer.elapsed() >= measureSeconds / 4)
+                    break;
+            }
+
+            return timer.elapsed() / evaluated;
+        }
+
+        Population<double> population{ initialization<double>(bounds, sampleSize) };
+        std::vector<Chromosome*> rows{};
+        for(Chromosome& individual : population)
+            rows.push_back(&individual);
+
+        Timer timer;
+        for(std::size_t first {0}; evaluated < limit; first = (first + evaluationPiece) % rows.size())
+        {
+            const std::size_t count{ std::min(evaluationPiece, rows.size() - first) };
+            evaluateBatch(std::span<Chromosome* const>(rows.data() + first, count), p.target_function, nullptr);
+            evaluated += static_cast<double>(count);
+
+            if(timer.elapsed() >= measureSeconds / 4)
+                break;
+        }
+
+        return timer.elapsed() / evaluated;
+    }
+
+    /// @brief Average cost of an empty fork/join of `threads` threads.
+    double measureForkJoin(int threads)
+    {
+        constexpr int rounds{ 64 };
+        int sink{ 0 };
+
+        Timer timer;
+        for(int r {0}; r < rounds; ++r)
+        {
+            #pragma omp parallel num_threads(threads) reduction(+:sink)
+            sink += 1;
+        }
+
+        return sink > 0 ? timer.elapsed() / rounds : 0.0;
+    }
+
+    /// @brief Average wall time of one GA generation with `threads` threads, on the path runOptimizer takes for `p`
+    /// (fixed genome, vector genome, float or double): a run of `generations` generations minus a run that only
+    /// builds and evaluates the initial population, which also warms up the buffers and the thread pool.
+    double measureGenerations(const Parameters& p, int threads, int generations)
+    {
+        Parameters calibration{ p };
+        calibration.num_tests = 1;
+        calibration.trace_length = 0;
+
+        const auto timedRun{ [&calibration, threads](int nIterations)
+        {
+            calibration.nIterations = nIterations;
+
+            Timer timer;
+            const RunResult result{ runOptimizer(calibration, threads, threads > 1) };
+            return std::pair{ timer.elapsed(), std::max(1, result.generations) };
+        } };
+
+        const double setup{ timedRun(0).first };
+        const auto [seconds, done]{ timedRun(generations) };
+
+        return std::max(seconds - setup, 1e-9) / done;
+    }
+
+    /// @brief Times every candidate with as many generations as the calibration budget allows.
+    /// @return false if not even one generation per candidate fits; the caller then models the generation time
+    bool measureGA(const Parameters& p, double evaluationSeconds, double budget, const std::vector<int>& candidates, ParallelPlan& plan)
+    {
+        // Cada candidato avalia a população inicial duas vezes e cerca de duas linhas por filho a cada geração
+        const double perCandidate{ budget / static_cast<double>(candidates.size()) };
+        const double rowsPerGeneration{ 2.0 * std::max(1, p.pop_size) };
+        const double byEvaluations{ perCandidate / rowsPerGeneration - 1.0 };
+        const double bySeconds{ maxCalibrationSeconds / static_cast<double>(candidates.size()) / std::max(rowsPerGeneration * evaluationSeconds, 1e-12) - 1.0 };
+        const int generations{ static_cast<int>(std::min({ byEvaluations, bySeconds, static_cast<double>(maxMeasuredGenerations) })) };
+
+        if(generations < 1)
+            return false;
+
+        // O GA imprime a última geração; a calibração fica fora da saída
+        std::ostringstream discard{};
+        std::streambuf* const console{ std::cout.rdbuf(discard.rdbuf()) };
+
+        for(int threads : candidates)
+            plan.generationSeconds.emplace_back(threads, measureGenerations(p, threads, generations));
+
+        std::cout.rdbuf(console);
+        return true;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+ParallelPlan tuneParallelism(const Parameters& p, int maxThreads)
+{
+    ParallelPlan plan{};
+    Timer timer;
+
+    const int numTests{ std::max(1, p.num_tests) };
+    maxThreads = std::max(1, maxThreads);
+
+    const SearchBounds bounds{ p.target_function, p.dimensions, p.boundary_handling };
+    const double budget{ evaluationBudget(p) };
+    plan.evaluationSeconds = measureEvaluation(p, bounds, budget);
+
+    if(p.threads_per_test > 0)
+    {
+        plan.threadsPerTest = std::min(p.threads_per_test, maxThreads);
+        plan.reason = "threads_per_test from the config file";
+    }
+    else if(maxThreads == 1)
+        plan.reason = "single thread available";
+    else if(numTests >= maxThreads)
+        plan.reason = "num_tests >= threads: every core runs whole tests";
+    else
+    {
+        const std::vector<int> candidates{ candidateThreads(maxThreads) };
+
+        const bool measured{ p.engine == Engine::ga && measureGA(p, plan.evaluationSeconds, budget, candidates, plan) };
+        if(!measured)
+        {
+            // DE e CMA-ES só paralelizam a avaliação, e o GA cai aqui quando a calibração não cabe no orçamento:
+            // tempo modelado a partir das medidas
+            const int evaluations{ p.engine == Engine::cmaes ? std::max(4, p.cma_lambda > 0 ? p.cma_lambda : 4 + static_cast<int>(3 * std::log(static_cast<double>(bounds.size())))) : p.engine == Engine::ga ? 2 * p.pop_size : p.pop_size };
+            const double evaluationWork{ evaluations * plan.evaluationSeconds };
+
+            for(int threads : candidates)
+                plan.generationSeconds.emplace_back(threads, threads == 1 ? evaluationWork : evaluationWork / threads + measureForkJoin(threads));
+        }
+
+        // Menor tempo total previsto; empates ficam com menos threads por teste
+        double bestMakespan{ std::numeric_limits<double>::infinity() };
+        for(const auto& [threads, seconds] : plan.generationSeconds)
+        {
+            const int concurrent{ std::min(numTests, maxThreads / threads) };
+            const double makespan{ std::ceil(static_cast<double>(numTests) / concurrent) * seconds };
+
+            if(makespan < bestMakespan * 0.98)
+            {
+                bestMakespan = makespan;
+                plan.threadsPerTest = threads;
+            }
+        }
+
+        plan.reason = measured ? "shortest measured wall time" : "shortest modelled wall time";
+    }
+
+    plan.concurrentTests = std::clamp(maxThreads / plan.threadsPerTest, 1, numTests);
+
+    if(p.parallel_chunk > 0)
+        plan.chunkSize = p.parallel_chunk;
+    else if(plan.threadsPerTest > 1)
+    {
+        // Pedaços menores que uma fatia por thread só quando cada um ainda custa minChunkSeconds
+        const double perIndividual{ plan.generationSeconds.empty() || p.engine != Engine::ga
+                                    ? plan.evaluationSeconds
+                                    : plan.generationSeconds.front().second / std::max(1, p.pop_size) };
+        const int slice{ std::max(1, p.pop_size / plan.threadsPerTest) };
+        const int chunk{ static_cast<int>(std::ceil(minChunkSeconds / std::max(perIndividual, 1e-12))) };
+
+        plan.chunkSize = chunk * 4 <= slice ? std::max(chunk, 16) : 0;
+    }
+
+    plan.calibrationSeconds = timer.elapsed();
+
+    return plan;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void printParallelPlan(const ParallelPlan& plan, const Parameters& p)
+{
+    std::cout << std::setprecision(3);
+    std::cout << "Parallelism (tuned in " << plan.calibrationSeconds << "s): " << plan.reason << '\n';
+    std::cout << "\t Evaluation: " << 1e6 * plan.evaluationSeconds << " us per individual\n";
+
+    if(!plan.generationSeconds.empty())
+    {
+        std::cout << "\t Generation time by threads per run:";
+        for(const auto& [threads, seconds] : plan.generationSeconds)
+            std::cout << "  " << threads << ": " << 1e3 * seconds << " ms";
+        std::cout << '\n';
+    }
+
+    std::cout << "\t Concurrent runs: " << plan.concurrentTests << "  |  Threads per run: " << plan.threadsPerTest
+              << "  |  Chunk: " << (plan.chunkSize > 0 ? std::to_string(plan.chunkSize) + " individuals" : std::string{ "one slice per thread" }) << "\n\n";
+
+    Settings::setup_precision(p.print_precision);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include "Parameters.h"
+
+// Runtime choice of how the cores are split between concurrent tests and threads inside each test.
+// Replaces the fixed population/dimension thresholds: a few calibration generations are timed on the
+// actual configuration, through the same runOptimizer dispatch as the tests, and the split with the
+// shortest predicted wall time wins. Calibration is capped at a small share of the evaluations the tests
+// will make and a fixed wall time; when not even one generation per candidate fits, the generation time
+// is modelled from the measured evaluation cost instead.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+struct ParallelPlan
+{
+    int    concurrentTests{ 1 };    // runs executing at the same time
+    int    threadsPerTest{ 1 };     // threads inside each run; > 1 means the run is parallel
+    int    chunkSize{ 0 };          // individuals per scheduling chunk inside a run, 0 = one slice per thread
+
+    double evaluationSeconds{};     // measured cost of one fitness evaluation
+    double calibrationSeconds{};    // time spent measuring
+
+    // Measured (GA) or modelled (DE, CMA-ES) generation time for each candidate thread count
+    std::vector<std::pair<int, double>> generationSeconds{};
+    const char* reason{ "" };
+};
+
+/// @brief Picks concurrentTests x threadsPerTest <= maxThreads minimizing ceil(num_tests / concurrent) * generation(threads).
+///
+/// `threads_per_test` and `parallel_chunk` from the config file override the measured choices.
+ParallelPlan tuneParallelism(const Parameters& p, int maxThreads);
+
+void printParallelPlan(const ParallelPlan& plan, const Parameters& p);
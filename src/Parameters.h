@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include "constants.h"
 
+/// @brief Run configuration loaded from the config file.
+///
+/// Shared read-only by every run; per-run mutable values live in RunState.
 struct Parameters 
 {
    int             nIterations;
@@ -15,8 +20,54 @@ struct Parameters
    int             dimensions;
    SelectionMethod method;
    Points          points;
-   double          mutation_rate;
-   double          mutation_strength;
    int             print_precision;
    int             num_tests;
+   int             fitness_cache_size;
+   BoundaryHandling boundary_handling;
+   Engine          engine;
+   double          differential_weight;
+   double          crossover_rate;
+   int             cma_lambda;
+   MutationSchedule schedule;
+   Precision       precision;
+   int             polish_evaluations;
+   InitSampling    init_sampling;
+   bool            large_population;
+   int             memory_budget_mb;
+   bool            out_of_core;
+   std::string     tile_directory;
+   int             islands;
+   int             island_rank;
+   TransportType   transport;
+   std::string     coordinator_address;
+   int             migration_interval;
+   int             migration_size;
+   double          stop_fitness;
+   bool            stop_at_fitness;
+   double          blx_alpha;
+   double          sbx_eta;
+   int             tournament_size;
+   std::string     results_file;
+   ResultsFormat   results_format;
+   int             trace_length;
+   int             threads_per_test;
+   int             parallel_chunk;
+   ObjectiveFunction objective_function;
+   int             objectives;
+   std::string     pareto_file;
+   SurrogateType   surrogate;
+   double          surrogate_fraction;
+   int             surrogate_archive;
+   int             surrogate_neighbors;
+   LocalSearch     local_search;
+   int             local_search_interval;
+   int             local_search_elites;
+   int             local_search_evaluations;
+   Niching         niching;
+   double          niche_radius;
+   int             niche_capacity;
+   std::uint64_t   seed;
+   bool            perf_counters;
+   TransformType   transform;
+   std::uint64_t   transform_seed;
 };
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    class ThreadCounters;
+
+    std::atomic<bool>            samplingEnabled{ false };
+    std::mutex                   registryMutex{};
+    std::vector<ThreadCounters*> registry{};
+    PerfProfile                  retired{};   // totais de threads que já terminaram
+
+    constexpr std::array<const char*, perfEventCount> eventNames{ "task-clock", "cycles", "instructions", "cache-misses", "branch-misses", "LLC-loads" };
+
+    /// @brief The counter group of one thread, opened on first use and kept until the thread exits.
+    class ThreadCounters
+    {
+    public:
+        ThreadCounters();
+        ~ThreadCounters();
+
+        ThreadCounters(const ThreadCounters&) = delete;
+        ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+        /// @brief Current value of every open counter, scaled when the kernel multiplexed the group.
+        bool read(std::array<std::uint64_t, perfEventCount>& values) const;
+
+        PerfProfile profile{};
+
+    private:
+        std::array<int, perfEventCount> m_fds{};
+        std::array<std::size_t, perfEventCount> m_order{};   // evento de cada posição na leitura do grupo
+        std::size_t m_members{ 0 };
+    };
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef __linux__
+    perf_event_attr eventAttributes(PerfEvent event)
+    {
+        perf_event_attr attr{};
+        attr.size           = sizeof(perf_event_attr);
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.exclude_kernel = 1;   // com perf_event_paranoid = 2 só o espaço de usuário pode ser medido
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch(event)
+        {
+        case PerfEvent::task_clock:
+            attr.type   = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_TASK_CLOCK;
+            break;
+        case PerfEvent::cycles:
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfEvent::instructions:
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfEvent::cache_misses:
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfEvent::branch_misses:
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfEvent::llc_loads:
+            attr.type   = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16);
+            break;
+        }
+
+        return attr;
+    }
+#endif
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    ThreadCounters::ThreadCounters()
+    {
+        m_fds.fill(-1);
+
+#ifdef __linux__
+        // Um único grupo: o primeiro evento aberto lidera e uma leitura traz todos os valores juntos
+        for(std::size_t e {0}; e < perfEventCount; ++e)
+        {
+            perf_event_attr attr{ eventAttributes(static_cast<PerfEvent>(e)) };
+            const int leader{ m_members > 0 ? m_fds[m_order[0]] : -1 };
+            const long fd{ syscall(SYS_perf_event_open, &attr, 0, -1, leader, PERF_FLAG_FD_CLOEXEC) };
+
+            if(fd < 0)
+            {
+                if(profile.error.empty())
+                    profile.error = std::string{ "perf_event_open(" } + eventNames[e] + "): " + std::strerror(errno);
+                continue;
+            }
+
+            m_fds[e] = static_cast<int>(fd);
+            m_order[m_members++] = e;
+            profile.available[e] = true;
+        }
+#else
+        profile.error = "perf_event_open is only available on Linux";
+#endif
+
+        const std::lock_guard<std::mutex> lock{ registryMutex };
+        registry.push_back(this);
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    ThreadCounters::~ThreadCounters()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{ registryMutex };
+            retired += profile;
+            registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+        }
+
+#ifdef __linux__
+        for(const int fd : m_fds)
+            if(fd >= 0)
+                close(fd);
+#endif
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    bool ThreadCounters::read(std::array<std::uint64_t, perfEventCount>& values) const
+    {
+#ifdef __linux__
+        if(m_members == 0)
+            return false;
+
+        // Formato do grupo: nr, tempo habilitado, tempo em execução e um valor por membro
+        std::array<std::uint64_t, 3 + perfEventCount> buffer{};
+        const std::size_t bytes{ (3 + m_members) * sizeof(std::uint64_t) };
+        if(::read(m_fds[m_order[0]], buffer.data(), bytes) != static_cast<ssize_t>(bytes))
+            return false;
+
+        const std::uint64_t enabled{ buffer[1] };
+        const std::uint64_t running{ buffer[2] };
+        const double scale{ running > 0 && running < enabled ? static_cast<double>(enabled) / static_cast<double>(running) : 1.0 };
+
+        for(std::size_t k {0}; k < m_members; ++k)
+            values[m_order[k]] = static_cast<std::uint64_t>(static_cast<double>(buffer[3 + k]) * scale);
+
+        return true;
+#else
+        (void)values;
+        return false;
+#endif
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    ThreadCounters& threadCounters()
+    {
+        thread_local ThreadCounters counters{};
+        return counters;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+bool PerfProfile::any() const
+{
+    return std::any_of(available.begin(), available.end(), [](bool open) { return open; });
+}
+
+double PerfProfile::ipc(GaPhase phase) const
+{
+    const PhaseCounters& counters{ phases[static_cast<std::size_t>(phase)] };
+    const std::uint64_t cycles{ counters.values[static_cast<std::size_t>(PerfEvent::cycles)] };
+
+    if(!available[static_cast<std::size_t>(PerfEvent::cycles)] || !available[static_cast<std::size_t>(PerfEvent::instructions)] || cycles == 0)
+        return -1.0;
+
+    return static_cast<double>(counters.values[static_cast<std::size_t>(PerfEvent::instructions)]) / static_cast<double>(cycles);
+}
+
+double PerfProfile::perIndividual(GaPhase phase, PerfEvent event) const
+{
+    const PhaseCounters& counters{ phases[static_cast<std::size_t>(phase)] };
+
+    if(!available[static_cast<std::size_t>(event)] || counters.individuals == 0)
+        return -1.0;
+
+    return static_cast<double>(counters.values[static_cast<std::size_t>(event)]) / static_cast<double>(counters.individuals);
+}
+
+PerfProfile& PerfProfile::operator+=(const PerfProfile& other)
+{
+    for(std::size_t phase {0}; phase < gaPhaseCount; ++phase)
+        phases[phase] += other.phases[phase];
+
+    for(std::size_t e {0}; e < perfEventCount; ++e)
+        available[e] = available[e] || other.available[e];
+
+    if(error.empty())
+        error = other.error;
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void PerfCounters::enable()
+{
+    samplingEnabled.store(true, std::memory_order_relaxed);
+}
+
+bool PerfCounters::enabled()
+{
+    return samplingEnabled.load(std::memory_order_relaxed);
+}
+
+PerfProfile PerfCounters::collect()
+{
+    const std::lock_guard<std::mutex> lock{ registryMutex };
+
+    PerfProfile total{ retired };
+    for(const ThreadCounters* counters : registry)
+        total += counters->profile;
+
+    return total;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+PhaseScope::PhaseScope(GaPhase phase, std::size_t individuals)
+    : m_phase{ phase }, m_individuals{ individuals }
+{
+    if(PerfCounters::enabled())
+        m_active = threadCounters().read(m_start);
+}
+
+PhaseScope::~PhaseScope()
+{
+    if(!m_active)
+        return;
+
+    ThreadCounters& counters{ threadCounters() };
+    std::array<std::uint64_t, perfEventCount> end{};
+    if(!counters.read(end))
+        return;
+
+    PhaseCounters& totals{ counters.profile.phases[static_cast<std::size_t>(m_phase)] };
+    for(std::size_t e {0}; e < perfEventCount; ++e)
+        totals.values[e] += end[e] - std::min(end[e], m_start[e]);
+    totals.individuals += m_individuals;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Hardware performance counters per GA phase (`perf_counters` key). Every worker thread opens its own group
+// of counters through perf_event_open the first time it enters a phase, and PhaseScope adds the counter
+// deltas of each phase to that thread's totals. Linux only: elsewhere, or when the kernel refuses the events
+// (perf_event_paranoid, containers, VMs without a virtual PMU), the scopes do nothing and the report says why.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar as fases de uma geração medidas pelos contadores
+enum class GaPhase {
+    selection,   // vetor de fitness, nichos e torneios
+    crossover,
+    mutation,    // mutação, correção de limites e aceitação
+    evaluation,
+    sort
+};
+
+// Enum para representar os contadores abertos por thread
+enum class PerfEvent {
+    task_clock,      // tempo de CPU em ns (evento de software, disponível mesmo sem PMU)
+    cycles,
+    instructions,
+    cache_misses,
+    branch_misses,
+    llc_loads
+};
+
+constexpr std::size_t gaPhaseCount{ 5 };
+constexpr std::size_t perfEventCount{ 6 };
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+struct PhaseCounters
+{
+    std::array<std::uint64_t, perfEventCount> values{};
+    std::uint64_t individuals{};   // indivíduos processados na fase, para as médias por indivíduo
+
+    PhaseCounters& operator+=(const PhaseCounters& other)
+    {
+        for(std::size_t e {0}; e < perfEventCount; ++e)
+            values[e] += other.values[e];
+        individuals += other.individuals;
+        return *this;
+    }
+};
+
+/// @brief Counter totals of every thread, one entry per phase.
+struct PerfProfile
+{
+    std::array<PhaseCounters, gaPhaseCount> phases{};
+    std::array<bool, perfEventCount>        available{};   // eventos que alguma thread conseguiu abrir
+    std::string                             error{};       // motivo do primeiro evento recusado
+
+    bool any() const;
+    double ipc(GaPhase phase) const;
+    /// @return event count per individual of the phase, or a negative value when the event is unavailable
+    double perIndividual(GaPhase phase, PerfEvent event) const;
+
+    PerfProfile& operator+=(const PerfProfile& other);
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Process-wide switch and collection of the per-thread counters.
+class PerfCounters
+{
+public:
+    /// @brief Turns sampling on; PhaseScope is a no-op until then.
+    static void        enable();
+    static bool        enabled();
+    /// @brief Sum of every thread's totals, including threads that already exited. Call outside parallel regions.
+    static PerfProfile collect();
+};
+
+/// @brief Adds the counter deltas between construction and destruction to `phase` of the calling thread.
+class PhaseScope
+{
+public:
+    explicit PhaseScope(GaPhase phase, std::size_t individuals);
+    ~PhaseScope();
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    GaPhase                                    m_phase;
+    std::size_t                                m_individuals;
+    bool                                       m_active{};
+    std::array<std::uint64_t, perfEventCount>  m_start{};
+};
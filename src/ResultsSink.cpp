@@ -0,0 +1,343 @@
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include "ResultsSink.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    void appendNumber(std::string& line, double value)
+    {
+        char digits[32];
+        const auto [end, ec] { std::to_chars(digits, digits + sizeof(digits), value) };
+        line.append(digits, end);
+    }
+
+    void appendNumber(std::string& line, int value)
+    {
+        char digits[16];
+        const auto [end, ec] { std::to_chars(digits, digits + sizeof(digits), value) };
+        line.append(digits, end);
+    }
+
+    template <typename T>
+    void writeRaw(std::ofstream& file, const T& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeHeader(std::ofstream& file, const char (&magic)[8], std::uint32_t dimensions, std::uint32_t blockRows)
+    {
+        const std::uint32_t flags{ std::endian::native == std::endian::big ? 1u : 0u };
+
+        file.write(magic, sizeof(magic));
+        writeRaw(file, std::uint32_t{ 1 });
+        writeRaw(file, dimensions);
+        writeRaw(file, blockRows);
+        writeRaw(file, flags);
+    }
+
+    void openBuffered(std::ofstream& file, std::vector<char>& buffer, const std::string& path)
+    {
+        buffer.resize(1 << 20);
+        file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.open(path, std::ios::binary | std::ios::trunc);
+
+        if(!file.is_open())
+        {
+            std::cerr << "Unable to open results file: " << path << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /// @brief Writes one column of a block, gathering `field` from every row.
+    template <typename T, typename Field>
+    void writeColumn(std::ofstream& file, std::vector<T>& scratch, std::size_t rows, Field field)
+    {
+        scratch.resize(rows);
+        for(std::size_t i {0}; i < rows; ++i)
+            scratch[i] = field(i);
+
+        file.write(reinterpret_cast<const char*>(scratch.data()), static_cast<std::streamsize>(rows * sizeof(T)));
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+ResultsSink::ResultsSink(const std::string& path, ResultsFormat format, bool traces)
+    : m_format{ format }
+{
+    // Buffer grande: a thread de escrita faz poucas chamadas ao sistema mesmo com milhares de execuções
+    openBuffered(m_file, m_buffer, path);
+
+    if(traces)
+    {
+        openBuffered(m_traceFile, m_traceBuffer, traceFilePath(path));
+
+        if(m_format == ResultsFormat::csv)
+            m_traceFile << "test,generation,best,mean,worst,diversity,mutation_rate,mutation_strength\n";
+        else
+            writeHeader(m_traceFile, { 'G', 'A', 'O', 'T', 'R', 'C', '1', '\0' }, 8, blockRows);
+    }
+
+    m_writer = std::thread{ &ResultsSink::writerLoop, this };
+}
+
+ResultsSink::~ResultsSink()
+{
+    close();
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void ResultsSink::push(int test, const RunResult& result)
+{
+    const std::span<const double> genes{ result.best.genes() };
+
+    Row row{ test, result.best.get_fitness(), result.seconds, result.generations, result.stop, { genes.begin(), genes.end() }, {} };
+    if(m_traceFile.is_open())
+        row.trace = result.trace;
+
+    {
+        std::lock_guard<std::mutex> lock{ m_mtx };
+        m_queue.push_back(std::move(row));
+    }
+    m_ready.notify_one();
+}
+
+void ResultsSink::close()
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_mtx };
+        if(m_closing)
+            return;
+        m_closing = true;
+    }
+    m_ready.notify_one();
+
+    if(m_writer.joinable())
+        m_writer.join();
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void ResultsSink::writerLoop()
+{
+    std::vector<Row> rows{};
+
+    for(;;)
+    {
+        bool closing{};
+        {
+            std::unique_lock<std::mutex> lock{ m_mtx };
+            m_ready.wait(lock, [this] { return m_closing || !m_queue.empty(); });
+
+            rows.assign(std::make_move_iterator(m_queue.begin()), std::make_move_iterator(m_queue.end()));
+            m_queue.clear();
+            closing = m_closing;
+        }
+
+        if(!rows.empty() && !m_headerWritten)
+            m_dimensions = rows.front().genes.size();
+
+        if(m_traceFile.is_open())
+            writeTraces(rows);
+
+        if(m_format == ResultsFormat::csv)
+            writeCsv(rows);
+        else
+            appendBlock(rows);
+
+        if(closing)
+            break;
+    }
+
+    // Último bloco, menor que blockRows
+    if(m_format == ResultsFormat::binary && !m_block.empty())
+        writeBlock();
+    if(m_format == ResultsFormat::binary && !m_traceBlock.empty())
+        writeTraceBlock();
+
+    for(std::ofstream* file : { &m_file, &m_traceFile })
+    {
+        if(!file->is_open())
+            continue;
+
+        file->flush();
+        if(!*file)
+            std::cerr << "Error while writing the results file" << std::endl;
+        file->close();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void ResultsSink::writeCsv(const std::vector<Row>& rows)
+{
+    std::string text{};
+
+    if(!m_headerWritten)
+    {
+        text += "test,fitness,generations,stop_reason,seconds";
+        for(std::size_t j {0}; j < m_dimensions; ++j)
+            text += ",x" + std::to_string(j);
+        text += '\n';
+        m_headerWritten = true;
+    }
+
+    for(const Row& row : rows)
+    {
+        appendNumber(text, row.test);
+        text += ',';
+        appendNumber(text, row.fitness);
+        text += ',';
+        appendNumber(text, row.generations);
+        text += ',';
+        text += getStopReasonName(row.stop);
+        text += ',';
+        appendNumber(text, row.seconds);
+
+        for(double gene : row.genes)
+        {
+            text += ',';
+            appendNumber(text, gene);
+        }
+        text += '\n';
+    }
+
+    m_file.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void ResultsSink::appendBlock(std::vector<Row>& rows)
+{
+    if(!m_headerWritten)
+    {
+        writeHeader(m_file, { 'G', 'A', 'O', 'R', 'E', 'S', '1', '\0' }, static_cast<std::uint32_t>(m_dimensions), blockRows);
+        m_headerWritten = true;
+    }
+
+    for(Row& row : rows)
+    {
+        m_block.push_back(std::move(row));
+        if(m_block.size() == blockRows)
+            writeBlock();
+    }
+}
+
+/// @brief Writes the pending rows as one block, column after column.
+void ResultsSink::writeBlock()
+{
+    const std::size_t rows{ m_block.size() };
+
+    writeRaw(m_file, static_cast<std::uint32_t>(rows));
+    writeRaw(m_file, std::uint32_t{ 0 });
+
+    std::vector<double> reals{};
+    std::vector<std::int32_t> integers{};
+
+    writeColumn(m_file, reals, rows, [this](std::size_t i) { return m_block[i].fitness; });
+    writeColumn(m_file, reals, rows, [this](std::size_t i) { return m_block[i].seconds; });
+    writeColumn(m_file, integers, rows, [this](std::size_t i) { return static_cast<std::int32_t>(m_block[i].test); });
+    writeColumn(m_file, integers, rows, [this](std::size_t i) { return static_cast<std::int32_t>(m_block[i].generations); });
+    writeColumn(m_file, integers, rows, [this](std::size_t i) { return static_cast<std::int32_t>(m_block[i].stop); });
+
+    if(rows & 1)
+        writeRaw(m_file, std::uint32_t{ 0 });
+
+    for(std::size_t j {0}; j < m_dimensions; ++j)
+        writeColumn(m_file, reals, rows, [this, j](std::size_t i) { return j < m_block[i].genes.size() ? m_block[i].genes[j] : 0.0; });
+
+    m_block.clear();
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void ResultsSink::writeTraces(std::vector<Row>& rows)
+{
+    if(m_format == ResultsFormat::binary)
+    {
+        for(Row& row : rows)
+        {
+            for(const GenerationStats& stats : row.trace)
+            {
+                m_traceBlock.push_back({ row.test, stats });
+                if(m_traceBlock.size() == blockRows)
+                    writeTraceBlock();
+            }
+            row.trace.clear();
+        }
+        return;
+    }
+
+    std::string text{};
+
+    for(Row& row : rows)
+    {
+        for(const GenerationStats& stats : row.trace)
+        {
+            appendNumber(text, row.test);
+            text += ',';
+            appendNumber(text, stats.generation);
+
+            for(double value : { stats.best, stats.mean, stats.worst, stats.diversity, stats.mutation_rate, stats.mutation_strength })
+            {
+                text += ',';
+                if(!std::isnan(value))
+                    appendNumber(text, value);
+            }
+            text += '\n';
+        }
+        row.trace.clear();
+    }
+
+    m_traceFile.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void ResultsSink::writeTraceBlock()
+{
+    const std::size_t rows{ m_traceBlock.size() };
+
+    writeRaw(m_traceFile, static_cast<std::uint32_t>(rows));
+    writeRaw(m_traceFile, std::uint32_t{ 0 });
+
+    std::vector<double> reals{};
+    std::vector<std::int32_t> integers{};
+
+    writeColumn(m_traceFile, integers, rows, [this](std::size_t i) { return static_cast<std::int32_t>(m_traceBlock[i].test); });
+    writeColumn(m_traceFile, integers, rows, [this](std::size_t i) { return static_cast<std::int32_t>(m_traceBlock[i].stats.generation); });
+
+    for(double GenerationStats::* column : { &GenerationStats::best, &GenerationStats::mean, &GenerationStats::worst,
+                                             &GenerationStats::diversity, &GenerationStats::mutation_rate, &GenerationStats::mutation_strength })
+        writeColumn(m_traceFile, reals, rows, [this, column](std::size_t i) { return m_traceBlock[i].stats.*column; });
+
+    m_traceBlock.clear();
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+std::string traceFilePath(const std::string& resultsPath)
+{
+    std::filesystem::path path{ resultsPath };
+    const std::filesystem::path extension{ path.extension() };
+
+    path.replace_extension();
+    path += ".trace";
+    path += extension;
+
+    return path.string();
+}
+
+std::string resultsPath(const Parameters& p)
+{
+    if(p.islands > 1 && p.transport != TransportType::loopback && p.island_rank > 0)
+        return p.results_file + ".rank" + std::to_string(p.island_rank);
+
+    return p.results_file;
+}
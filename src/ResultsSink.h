@@ -0,0 +1,99 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Parameters.h"
+#include "RunResult.h"
+
+// Per-run results file (`results_file` key). Runs are queued as they finish and written by a background
+// thread, so the optimizer threads never wait on formatting or disk.
+//
+// Binary layout (`results_format=binary`), host byte order (flags bit 0 set on big-endian hosts):
+//   header  char magic[8] = "GAORES1", u32 version, u32 dimensions, u32 blockRows, u32 flags
+//   block   u32 rows, u32 reserved,
+//           f64 fitness[rows], f64 seconds[rows], i32 test[rows], i32 generations[rows], i32 stop[rows],
+//           4 bytes of padding when rows is odd, f64 gene_j[rows] for j = 0 .. dimensions - 1
+// Blocks repeat until end of file; every block but the last holds blockRows rows.
+//
+// With `trace_length` > 0 the convergence traces go to a second file (traceFilePath), one row per
+// recorded generation. Its binary layout follows the same scheme with magic "GAOTRC1" and the
+// dimensions field holding the number of columns (8):
+//   block   u32 rows, u32 reserved, i32 test[rows], i32 generation[rows], f64 best[rows], f64 mean[rows],
+//           f64 worst[rows], f64 diversity[rows], f64 mutation_rate[rows], f64 mutation_strength[rows]
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+class ResultsSink
+{
+public:
+    static constexpr std::uint32_t blockRows{ 1024 };
+
+    /// @brief Opens `path` (truncating it), and its trace file when `traces` is set, and starts the writer thread.
+    ResultsSink(const std::string& path, ResultsFormat format, bool traces = false);
+    ~ResultsSink();
+
+    ResultsSink(const ResultsSink&) = delete;
+    ResultsSink& operator=(const ResultsSink&) = delete;
+
+    /// @brief Queues run number `test`; cheap and safe to call from any thread.
+    void push(int test, const RunResult& result);
+
+    /// @brief Writes everything still queued and closes the file. Called by the destructor as well.
+    void close();
+
+private:
+    struct Row
+    {
+        int                 test{};
+        double              fitness{};
+        double              seconds{};
+        int                 generations{};
+        StopReason          stop{};
+        std::vector<double> genes{};
+        std::vector<GenerationStats> trace{};
+    };
+
+    struct TraceRow
+    {
+        int             test{};
+        GenerationStats stats{};
+    };
+
+    void writerLoop();
+    void writeCsv(const std::vector<Row>& rows);
+    void appendBlock(std::vector<Row>& rows);
+    void writeBlock();
+    void writeTraces(std::vector<Row>& rows);
+    void writeTraceBlock();
+
+    std::ofstream           m_file;
+    ResultsFormat           m_format;
+    std::vector<char>       m_buffer;
+    std::size_t             m_dimensions{};
+    bool                    m_headerWritten{ false };
+    std::vector<Row>        m_block{};     // binary: rows of the block being filled
+
+    std::ofstream           m_traceFile{};
+    std::vector<char>       m_traceBuffer{};
+    std::vector<TraceRow>   m_traceBlock{};
+
+    std::mutex              m_mtx{};
+    std::condition_variable m_ready{};
+    std::deque<Row>         m_queue{};
+    bool                    m_closing{ false };
+    std::thread             m_writer{};
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Results file of this process: `results_file`, with `.rankN` appended on socket islands other than 0.
+std::string resultsPath(const Parameters& p);
+
+/// @brief Trace file next to `resultsPath`: "runs.csv" becomes "runs.trace.csv".
+std::string traceFilePath(const std::string& resultsPath);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Chromosome.h"
+#include "FitnessCache.h"
+#include "constants.h"
+#include "ConvergenceTrace.h"
+#include "Surrogate.h"
+
+// Non-dominated set of a multi-objective run, row-major
+struct ParetoFront
+{
+   std::size_t         objectives{};
+   std::size_t         dimensions{};
+   std::vector<double> values{};   // size() x objectives
+   std::vector<double> genes{};    // size() x dimensions
+
+   std::size_t size() const { return objectives ? values.size() / objectives : 0; }
+};
+
+// Everything a single run of the algorithm reports back to main
+struct RunResult
+{
+   Chromosome best{};
+   CacheStats cache{};
+   int        generations{};
+   StopReason stop{ StopReason::iterations };
+   double     seconds{};   // wall time of the run, filled in by main
+   std::vector<GenerationStats> trace{};   // last trace_length generations, oldest first
+   ParetoFront pareto{};                   // engine=nsga2 only
+   SurrogateStats surrogate{};             // surrogate pre-screening only
+
+   bool operator<(const RunResult& other) const { return best < other.best; }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "FitnessCache.h"
+#include "ConvergenceTrace.h"
+#include "Surrogate.h"
+
+/// @brief Mutable state of a single run.
+///
+/// Parameters is shared read-only by every concurrent run; anything that changes during a run
+/// (the mutation schedule, success counters, the fitness cache) lives here, one instance per run.
+struct RunState
+{
+   int           generation{};
+   double        mutation_rate{};
+   double        mutation_strength{};
+
+   // Filled in by the generation step, consumed by the adaptive (1/5 rule) schedule
+   int           mutation_attempts{};
+   int           mutation_successes{};
+
+   FitnessCache*     cache{};
+   ConvergenceTrace* trace{};       // null unless trace_length > 0
+   Surrogate*        surrogate{};   // null unless surrogate is set
+};
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include "Random.h"
+#include "SearchBounds.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+SearchBounds::SearchBounds(TargetFunction fnc, int dimensions, BoundaryHandling mode)
+    : m_mode{ mode }
+{
+    using enum BoundType;
+
+    auto bounds{ getBound(fnc) };
+
+    if(fnc == TargetFunction::mccormick)
+    {
+        auto bounds_pair{ std::get<BoundsPair>(bounds) };
+
+        auto [x_lower, x_upper]{ std::get<static_cast<int>(lower)>(bounds_pair) };
+        auto [y_lower, y_upper]{ std::get<static_cast<int>(higher)>(bounds_pair) };
+
+        m_lower = { x_lower, y_lower };
+        m_upper = { x_upper, y_upper };
+    }
+    else
+    {
+        auto [lower_bound, upper_bound]{ std::get<Bounds>(bounds) };
+
+        m_lower.assign(dimensions, lower_bound);
+        m_upper.assign(dimensions, upper_bound);
+    }
+
+    buildBoxes();
+}
+
+/// @brief Explicit box, for objectives that are not one of the benchmark functions.
+SearchBounds::SearchBounds(std::vector<double> lower, std::vector<double> upper, BoundaryHandling mode)
+    : m_lower{ std::move(lower) }, m_upper{ std::move(upper) }, m_mode{ mode }
+{
+    if(m_lower.size() != m_upper.size())
+        throw std::invalid_argument("Lower and upper bounds must have the same length.");
+
+    for(std::size_t i {0}; i < m_lower.size(); ++i)
+    {
+        if(!(m_lower[i] < m_upper[i]))
+            throw std::invalid_argument("Every lower bound must be below its upper bound.");
+    }
+
+    buildBoxes();
+}
+
+void SearchBounds::buildBoxes()
+{
+    m_boxD.lower = m_lower;
+    m_boxD.upper = m_upper;
+    m_boxD.width.resize(m_lower.size());
+    for(std::size_t i {0}; i < m_lower.size(); ++i)
+        m_boxD.width[i] = m_upper[i] - m_lower[i];
+
+    m_boxF.lower.assign(m_boxD.lower.begin(), m_boxD.lower.end());
+    m_boxF.upper.assign(m_boxD.upper.begin(), m_boxD.upper.end());
+    m_boxF.width.assign(m_boxD.width.begin(), m_boxD.width.end());
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SearchBounds::repair(T* genes, std::size_t n) const
+{
+    repairTile(genes, 0, n);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Repairs genes [first, first + count) of a genome, so a wide genome can be repaired tile by tile.
+template <typename T>
+void SearchBounds::repairTile(T* genes, std::size_t first, std::size_t count) const
+{
+    const std::size_t last{ std::min(first + count, m_lower.size()) };
+    if(first >= last)
+        return;
+
+    switch(m_mode)
+    {
+        case BoundaryHandling::clamp:   clamp(genes, first, last);   break;
+        case BoundaryHandling::reflect: reflect(genes, first, last); break;
+        case BoundaryHandling::wrap:    wrap(genes, first, last);    break;
+        case BoundaryHandling::reinit:  reinit(genes, first, last);  break;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Repairs `count` genomes laid out contiguously, `stride` genes apart, in one pass over the block.
+template <typename T>
+void SearchBounds::repairBlock(T* genes, std::size_t count, std::size_t stride) const
+{
+    using Kernel = void (SearchBounds::*)(T*, std::size_t, std::size_t) const;
+
+    // Modo resolvido uma vez para o bloco inteiro
+    Kernel kernel{ &SearchBounds::clamp<T> };
+    switch(m_mode)
+    {
+        case BoundaryHandling::clamp:   kernel = &SearchBounds::clamp<T>;   break;
+        case BoundaryHandling::reflect: kernel = &SearchBounds::reflect<T>; break;
+        case BoundaryHandling::wrap:    kernel = &SearchBounds::wrap<T>;    break;
+        case BoundaryHandling::reinit:  kernel = &SearchBounds::reinit<T>;  break;
+    }
+
+    const std::size_t last{ std::min(stride, m_lower.size()) };
+    for(std::size_t i {0}; i < count; ++i)
+        (this->*kernel)(genes + i * stride, 0, last);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SearchBounds::clamp(T* __restrict genes, std::size_t first, std::size_t last) const
+{
+    const T* __restrict lo{ box<T>().lower.data() };
+    const T* __restrict hi{ box<T>().upper.data() };
+
+    #pragma omp simd
+    for(std::size_t i = first; i < last; ++i)
+        genes[i] = std::min(std::max(genes[i], lo[i]), hi[i]);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Mirrors out-of-range genes back inside the box (repeatedly, if they overshoot by more than its width).
+template <typename T>
+void SearchBounds::reflect(T* __restrict genes, std::size_t first, std::size_t last) const
+{
+    const T* __restrict lo{ box<T>().lower.data() };
+    const T* __restrict hi{ box<T>().upper.data() };
+    const T* __restrict w { box<T>().width.data() };
+
+    #pragma omp simd
+    for(std::size_t i = first; i < last; ++i)
+    {
+        const T x{ genes[i] };
+        const T period{ T{ 2 } * w[i] };
+        T y{ std::fmod(x - lo[i], period) };
+        y = (y < T{ 0 }) ? y + period : y;
+        y = (y > w[i]) ? period - y : y;
+
+        genes[i] = (x < lo[i] || x > hi[i]) ? lo[i] + y : x;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Periodic boundaries: a gene leaving through one side re-enters through the other.
+template <typename T>
+void SearchBounds::wrap(T* __restrict genes, std::size_t first, std::size_t last) const
+{
+    const T* __restrict lo{ box<T>().lower.data() };
+    const T* __restrict hi{ box<T>().upper.data() };
+    const T* __restrict w { box<T>().width.data() };
+
+    #pragma omp simd
+    for(std::size_t i = first; i < last; ++i)
+    {
+        const T x{ genes[i] };
+        T y{ std::fmod(x - lo[i], w[i]) };
+        y = (y < T{ 0 }) ? y + w[i] : y;
+
+        genes[i] = (x < lo[i] || x > hi[i]) ? lo[i] + y : x;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Resamples out-of-range genes uniformly inside the box.
+template <typename T>
+void SearchBounds::reinit(T* genes, std::size_t first, std::size_t last) const
+{
+    const Box<T>& b{ box<T>() };
+
+    for(std::size_t i {first}; i < last; ++i)
+    {
+        if(genes[i] < b.lower[i] || genes[i] > b.upper[i])
+            genes[i] = Random::get(b.lower[i], b.upper[i]);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template void SearchBounds::repair<float>(float*, std::size_t) const;
+template void SearchBounds::repair<double>(double*, std::size_t) const;
+template void SearchBounds::repairTile<float>(float*, std::size_t, std::size_t) const;
+template void SearchBounds::repairTile<double>(double*, std::size_t, std::size_t) const;
+template void SearchBounds::repairBlock<float>(float*, std::size_t, std::size_t) const;
+template void SearchBounds::repairBlock<double>(double*, std::size_t, std::size_t) const;
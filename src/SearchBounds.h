@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include "constants.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Per-dimension search box of a run plus the repair applied to genes that leave it.
+///
+/// The lower/upper arrays are resolved once from the target function instead of unpacking
+/// getBound()'s variant for every individual.
+class SearchBounds
+{
+public:
+    SearchBounds() = default;
+    SearchBounds(TargetFunction fnc, int dimensions, BoundaryHandling mode = BoundaryHandling::clamp);
+    SearchBounds(std::vector<double> lower, std::vector<double> upper, BoundaryHandling mode = BoundaryHandling::clamp);
+
+    void                       repair(std::vector<double>& genes) const { repair(genes.data(), genes.size()); }
+    template <typename T>
+    void                       repair(T* genes, std::size_t n) const;
+    template <typename T>
+    void                       repairTile(T* genes, std::size_t first, std::size_t count) const;
+    template <typename T>
+    void                       repairBlock(T* genes, std::size_t count, std::size_t stride) const;
+
+    std::size_t                size() const { return m_lower.size(); }
+    double                     lower(std::size_t i) const { return m_lower[i]; }
+    double                     upper(std::size_t i) const { return m_upper[i]; }
+    const std::vector<double>& lower_array() const { return m_lower; }
+    const std::vector<double>& upper_array() const { return m_upper; }
+    BoundaryHandling           mode() const { return m_mode; }
+
+private:
+    // Limites na precisão dos genes, para que os kernels não convertam elemento a elemento
+    template <typename T>
+    struct Box
+    {
+        std::vector<T> lower{};
+        std::vector<T> upper{};
+        std::vector<T> width{};
+    };
+
+    template <typename T>
+    const Box<T>& box() const
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return m_boxF;
+        else
+            return m_boxD;
+    }
+
+    void                       buildBoxes();
+
+    template <typename T> void clamp(T* genes, std::size_t first, std::size_t last) const;
+    template <typename T> void reflect(T* genes, std::size_t first, std::size_t last) const;
+    template <typename T> void wrap(T* genes, std::size_t first, std::size_t last) const;
+    template <typename T> void reinit(T* genes, std::size_t first, std::size_t last) const;
+
+    std::vector<double> m_lower{};
+    std::vector<double> m_upper{};
+    Box<double>         m_boxD{};
+    Box<float>          m_boxF{};
+    BoundaryHandling    m_mode{ BoundaryHandling::clamp };
+};
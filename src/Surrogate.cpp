@@ -0,0 +1,366 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include "Surrogate.h"
+
+namespace {
+
+    // Centros do modelo rbf: os pontos mais recentes do arquivo, que ficam perto da população atual
+    constexpr std::size_t rbfCenters{ 256 };
+
+    // Regularização da diagonal; mantém a fatoração estável com centros quase repetidos
+    constexpr double rbfRidge{ 1e-6 };
+
+    constexpr std::size_t maxNeighbors{ 32 };
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+Surrogate::Surrogate(const Parameters& p, const SearchBounds& bounds)
+    : m_type{ p.surrogate },
+      m_dimensions{ bounds.size() },
+      m_capacity{ static_cast<std::size_t>(p.surrogate_archive > 0 ? p.surrogate_archive : 2048) },
+      m_neighbors{ std::clamp<std::size_t>(static_cast<std::size_t>(p.surrogate_neighbors > 0 ? p.surrogate_neighbors : 8), 1, maxNeighbors) },
+      m_minimum{ std::max(2 * m_neighbors, 2 * (m_dimensions + 1)) },
+      m_fraction{ p.surrogate_fraction > 0.0 ? std::min(p.surrogate_fraction, 1.0) : 0.25 }
+{
+    m_capacity = std::max(m_capacity, m_minimum);
+
+    m_lower = bounds.lower_array();
+    m_scale.resize(m_dimensions);
+    for(std::size_t j {0}; j < m_dimensions; ++j)
+        m_scale[j] = 1.0 / std::max(bounds.upper(j) - bounds.lower(j), std::numeric_limits<double>::min());
+
+    m_archive.reserve(m_capacity * m_dimensions);
+    m_archiveValues.reserve(m_capacity);
+
+    m_trainer = std::thread(&Surrogate::trainLoop, this);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+Surrogate::~Surrogate()
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_pendingMtx };
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+
+    if(m_trainer.joinable())
+        m_trainer.join();
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void Surrogate::record(std::span<const T> genes, double fitness)
+{
+    if(!std::isfinite(fitness))
+        return;
+
+    std::lock_guard<std::mutex> lock{ m_pendingMtx };
+
+    for(std::size_t j {0}; j < m_dimensions; ++j)
+        m_pending.push_back((static_cast<double>(genes[j]) - m_lower[j]) * m_scale[j]);
+    m_pendingValues.push_back(fitness);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void Surrogate::retrain()
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_pendingMtx };
+        if(m_pendingValues.empty())
+            return;
+        m_requested = true;
+    }
+    m_wake.notify_one();
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+std::shared_ptr<const SurrogateModel> Surrogate::model() const
+{
+    std::lock_guard<std::mutex> lock{ m_modelMtx };
+    return m_model;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void Surrogate::count(std::size_t evaluated, std::size_t screened)
+{
+    m_evaluated.fetch_add(evaluated, std::memory_order_relaxed);
+    m_screened.fetch_add(screened, std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void Surrogate::trainLoop()
+{
+    std::vector<double> genes{};
+    std::vector<double> values{};
+
+    for(;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock{ m_pendingMtx };
+            m_wake.wait(lock, [this] { return m_stopping || m_requested; });
+
+            if(m_stopping)
+                return;
+
+            m_requested = false;
+            genes.swap(m_pending);
+            values.swap(m_pendingValues);
+        }
+
+        // Entra no arquivo circular, sobrescrevendo os pontos mais antigos quando cheio
+        for(std::size_t i {0}; i < values.size(); ++i)
+        {
+            const double* point{ genes.data() + i * m_dimensions };
+
+            if(m_archiveValues.size() < m_capacity)
+            {
+                m_archive.insert(m_archive.end(), point, point + m_dimensions);
+                m_archiveValues.push_back(values[i]);
+            }
+            else
+            {
+                std::copy(point, point + m_dimensions, m_archive.begin() + static_cast<std::ptrdiff_t>(m_archiveNext * m_dimensions));
+                m_archiveValues[m_archiveNext] = values[i];
+            }
+
+            m_archiveNext = (m_archiveNext + 1) % m_capacity;
+        }
+
+        genes.clear();
+        values.clear();
+
+        if(m_archiveValues.size() < m_minimum)
+            continue;
+
+        std::shared_ptr<const SurrogateModel> model{ train() };
+
+        std::lock_guard<std::mutex> lock{ m_modelMtx };
+        m_model = std::move(model);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+std::shared_ptr<const SurrogateModel> Surrogate::train() const
+{
+    auto model{ std::make_shared<SurrogateModel>() };
+    model->m_type       = m_type;
+    model->m_dimensions = m_dimensions;
+    model->m_neighbors  = std::min(m_neighbors, m_archiveValues.size());
+    model->m_lower      = m_lower;
+    model->m_scale      = m_scale;
+
+    // Se o sistema do rbf não fatorar, o snapshot cai para vizinhos mais próximos
+    if(m_type == SurrogateType::rbf && fitRadial(*model))
+        return model;
+
+    model->m_type   = SurrogateType::knn;
+    model->m_points = m_archive;
+    model->m_values = m_archiveValues;
+
+    return model;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Gaussian RBF interpolation on the most recent archive points: solves (Phi + ridge I) w = f - mean by Cholesky.
+/// @return false if the system is not positive definite
+bool Surrogate::fitRadial(SurrogateModel& model) const
+{
+    const std::size_t size{ m_archiveValues.size() };
+    const std::size_t n{ std::min(rbfCenters, size) };
+    const std::size_t d{ m_dimensions };
+
+    model.m_points.resize(n * d);
+    model.m_values.resize(n);
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        const std::size_t source{ (m_archiveNext + size - 1 - i) % size };
+        std::copy_n(m_archive.begin() + static_cast<std::ptrdiff_t>(source * d), d, model.m_points.begin() + static_cast<std::ptrdiff_t>(i * d));
+        model.m_values[i] = m_archiveValues[source];
+    }
+
+    std::vector<double> distances(n * n, 0.0);
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        for(std::size_t k {i + 1}; k < n; ++k)
+        {
+            double sum{ 0.0 };
+            for(std::size_t j {0}; j < d; ++j)
+            {
+                const double diff{ model.m_points[i * d + j] - model.m_points[k * d + j] };
+                sum += diff * diff;
+            }
+            distances[i * n + k] = distances[k * n + i] = sum;
+        }
+    }
+
+    // Largura: distância média ao vizinho mais próximo entre os centros
+    double spacing{ 0.0 };
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        double nearest{ std::numeric_limits<double>::max() };
+        for(std::size_t k {0}; k < n; ++k)
+            if(k != i && distances[i * n + k] > 0.0)
+                nearest = std::min(nearest, distances[i * n + k]);
+        if(nearest < std::numeric_limits<double>::max())
+            spacing += std::sqrt(nearest);
+    }
+    spacing = std::max(spacing / static_cast<double>(n), 1e-9);
+    model.m_gamma = 1.0 / (2.0 * spacing * spacing);
+
+    double mean{ 0.0 };
+    for(double v : model.m_values)
+        mean += v;
+    model.m_mean = mean / static_cast<double>(n);
+
+    // Matriz do sistema sobrescrita pelo fator de Cholesky (triângulo inferior)
+    std::vector<double>& a{ distances };
+    for(std::size_t i {0}; i < n; ++i)
+        for(std::size_t k {0}; k <= i; ++k)
+            a[i * n + k] = std::exp(-model.m_gamma * a[i * n + k]) + (i == k ? rbfRidge : 0.0);
+
+    for(std::size_t k {0}; k < n; ++k)
+    {
+        double diag{ a[k * n + k] };
+        for(std::size_t j {0}; j < k; ++j)
+            diag -= a[k * n + j] * a[k * n + j];
+        if(!(diag > 0.0))
+            return false;
+        diag = std::sqrt(diag);
+        a[k * n + k] = diag;
+
+        for(std::size_t i {k + 1}; i < n; ++i)
+        {
+            double sum{ a[i * n + k] };
+            for(std::size_t j {0}; j < k; ++j)
+                sum -= a[i * n + j] * a[k * n + j];
+            a[i * n + k] = sum / diag;
+        }
+    }
+
+    std::vector<double>& w{ model.m_weights };
+    w.resize(n);
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        double sum{ model.m_values[i] - model.m_mean };
+        for(std::size_t j {0}; j < i; ++j)
+            sum -= a[i * n + j] * w[j];
+        w[i] = sum / a[i * n + i];
+    }
+    for(std::size_t i {n}; i-- > 0;)
+    {
+        double sum{ w[i] };
+        for(std::size_t j {i + 1}; j < n; ++j)
+            sum -= a[j * n + i] * w[j];
+        w[i] = sum / a[i * n + i];
+    }
+
+    return std::all_of(w.begin(), w.end(), [](double v) { return std::isfinite(v); });
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+double SurrogateModel::predict(std::span<const T> genes) const
+{
+    return m_type == SurrogateType::rbf ? predictRadial(genes) : predictNeighbors(genes);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Inverse-distance-weighted mean of the k nearest archive points (brute force over the archive).
+template <typename T>
+double SurrogateModel::predictNeighbors(std::span<const T> genes) const
+{
+    std::array<double, maxNeighbors> bestDistance{};
+    std::array<double, maxNeighbors> bestValue{};
+    std::size_t found{ 0 };
+
+    const std::size_t count{ m_values.size() };
+    for(std::size_t i {0}; i < count; ++i)
+    {
+        const double* point{ m_points.data() + i * m_dimensions };
+        const double limit{ found == m_neighbors ? bestDistance[found - 1] : std::numeric_limits<double>::max() };
+
+        double sum{ 0.0 };
+        for(std::size_t j {0}; j < m_dimensions && sum < limit; ++j)
+        {
+            const double diff{ (static_cast<double>(genes[j]) - m_lower[j]) * m_scale[j] - point[j] };
+            sum += diff * diff;
+        }
+
+        if(sum >= limit)
+            continue;
+
+        // Inserção ordenada na lista curta dos k melhores
+        std::size_t slot{ found < m_neighbors ? found++ : found - 1 };
+        while(slot > 0 && bestDistance[slot - 1] > sum)
+        {
+            bestDistance[slot] = bestDistance[slot - 1];
+            bestValue[slot]    = bestValue[slot - 1];
+            --slot;
+        }
+        bestDistance[slot] = sum;
+        bestValue[slot]    = m_values[i];
+    }
+
+    if(found == 0)
+        return std::numeric_limits<double>::max();
+    if(bestDistance[0] < 1e-24)
+        return bestValue[0];
+
+    double weighted{ 0.0 };
+    double total{ 0.0 };
+    for(std::size_t k {0}; k < found; ++k)
+    {
+        const double weight{ 1.0 / bestDistance[k] };
+        weighted += weight * bestValue[k];
+        total    += weight;
+    }
+
+    return weighted / total;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+double SurrogateModel::predictRadial(std::span<const T> genes) const
+{
+    double value{ m_mean };
+
+    const std::size_t count{ m_weights.size() };
+    for(std::size_t i {0}; i < count; ++i)
+    {
+        const double* center{ m_points.data() + i * m_dimensions };
+
+        double sum{ 0.0 };
+        for(std::size_t j {0}; j < m_dimensions; ++j)
+        {
+            const double diff{ (static_cast<double>(genes[j]) - m_lower[j]) * m_scale[j] - center[j] };
+            sum += diff * diff;
+        }
+
+        value += m_weights[i] * std::exp(-m_gamma * sum);
+    }
+
+    return value;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template void   Surrogate::record<float>(std::span<const float>, double);
+template void   Surrogate::record<double>(std::span<const double>, double);
+template double SurrogateModel::predict<float>(std::span<const float>) const;
+template double SurrogateModel::predict<double>(std::span<const double>) const;
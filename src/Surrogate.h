@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+#include "Parameters.h"
+#include "SearchBounds.h"
+
+// Surrogate-assisted pre-screening for the GA (`surrogate` key). A cheap regressor trained on every truly
+// evaluated genome predicts the fitness of new children; only the most promising `surrogate_fraction` of
+// them get a real evaluation, the other slots keep their individual from the previous generation.
+//
+// The archive and the model belong to a background thread: breeding only appends to a pending buffer and
+// reads the last published model, so retraining never stalls a generation.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+struct SurrogateStats
+{
+    std::uint64_t evaluated{};   // filhos avaliados de verdade
+    std::uint64_t screened{};    // filhos descartados só pela previsão
+
+    SurrogateStats& operator+=(const SurrogateStats& other)
+    {
+        evaluated += other.evaluated;
+        screened  += other.screened;
+        return *this;
+    }
+
+    double savedRate() const { return evaluated + screened ? static_cast<double>(screened) / static_cast<double>(evaluated + screened) : 0.0; }
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Immutable snapshot of a trained model; genes are normalized to the unit box before any distance.
+class SurrogateModel
+{
+public:
+    template <typename T>
+    double predict(std::span<const T> genes) const;
+
+private:
+    friend class Surrogate;
+
+    template <typename T>
+    double predictNeighbors(std::span<const T> genes) const;
+    template <typename T>
+    double predictRadial(std::span<const T> genes) const;
+
+    SurrogateType       m_type{};
+    std::size_t         m_dimensions{};
+    std::size_t         m_neighbors{};
+    std::vector<double> m_lower{};
+    std::vector<double> m_scale{};     // 1 / (upper - lower)
+    std::vector<double> m_points{};    // pontos normalizados, linha a linha
+    std::vector<double> m_values{};
+    std::vector<double> m_weights{};   // rbf: pesos dos centros
+    double              m_mean{};      // rbf: média removida antes do ajuste
+    double              m_gamma{};     // rbf: phi(r) = exp(-gamma r^2)
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+class Surrogate
+{
+public:
+    Surrogate(const Parameters& p, const SearchBounds& bounds);
+    ~Surrogate();
+
+    Surrogate(const Surrogate&) = delete;
+    Surrogate& operator=(const Surrogate&) = delete;
+
+    /// @brief Queues a truly evaluated genome for the next training round; safe to call from any thread.
+    template <typename T>
+    void record(std::span<const T> genes, double fitness);
+
+    /// @brief Wakes the trainer to fold the queued genomes into the archive and publish a new model.
+    void retrain();
+
+    /// @brief Latest published model; null until the archive is large enough to be trusted.
+    std::shared_ptr<const SurrogateModel> model() const;
+
+    /// @brief Share of each batch of children that gets a real evaluation.
+    double         fraction() const { return m_fraction; }
+
+    void           count(std::size_t evaluated, std::size_t screened);
+    SurrogateStats stats() const { return { m_evaluated.load(), m_screened.load() }; }
+
+private:
+    void trainLoop();
+    std::shared_ptr<const SurrogateModel> train() const;
+    bool fitRadial(SurrogateModel& model) const;
+
+    SurrogateType       m_type;
+    std::size_t         m_dimensions;
+    std::size_t         m_capacity;
+    std::size_t         m_neighbors;
+    std::size_t         m_minimum;
+    double              m_fraction;
+    std::vector<double> m_lower{};
+    std::vector<double> m_scale{};
+
+    // Arquivo circular, usado só pela thread de treino
+    std::vector<double> m_archive{};
+    std::vector<double> m_archiveValues{};
+    std::size_t         m_archiveNext{};
+
+    std::mutex              m_pendingMtx{};
+    std::condition_variable m_wake{};
+    std::vector<double>     m_pending{};
+    std::vector<double>     m_pendingValues{};
+    bool                    m_requested{};
+    bool                    m_stopping{};
+
+    mutable std::mutex                    m_modelMtx{};
+    std::shared_ptr<const SurrogateModel> m_model{};
+
+    std::atomic<std::uint64_t> m_evaluated{ 0 };
+    std::atomic<std::uint64_t> m_screened{ 0 };
+
+    std::thread m_trainer{};
+};
@@ -0,0 +1,398 @@
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include "Transport.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GAO_HAS_SOCKETS 1
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void LoopbackHub::push(int destination, Message message)
+{
+    Mailbox& box{ m_boxes.at(static_cast<std::size_t>(destination)) };
+    std::lock_guard lock{ box.mtx };
+    box.queue.push_back(std::move(message));
+}
+
+std::optional<Message> LoopbackHub::pop(int rank)
+{
+    Mailbox& box{ m_boxes.at(static_cast<std::size_t>(rank)) };
+    std::lock_guard lock{ box.mtx };
+
+    if(box.queue.empty())
+        return std::nullopt;
+
+    Message message{ std::move(box.queue.front()) };
+    box.queue.pop_front();
+    return message;
+}
+
+void LoopbackTransport::send(int destination, MessageType type, const std::vector<std::byte>& payload)
+{
+    m_hub.push(destination, Message{ m_rank, type, payload });
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef GAO_HAS_SOCKETS
+
+namespace {
+
+    constexpr std::size_t headerSize{ 4 * sizeof(std::uint32_t) };
+    constexpr int connectAttempts{ 300 };                      // 30 s em passos de 100 ms
+    constexpr std::chrono::milliseconds retryDelay{ 100 };
+
+    void putU32(std::byte* out, std::uint32_t value)
+    {
+        for(int i {0}; i < 4; ++i)
+            out[i] = static_cast<std::byte>((value >> (8 * i)) & 0xFFU);
+    }
+
+    std::uint32_t getU32(const std::byte* in)
+    {
+        std::uint32_t value{ 0 };
+        for(int i {0}; i < 4; ++i)
+            value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+        return value;
+    }
+
+    bool writeAll(int fd, const std::byte* data, std::size_t bytes)
+    {
+        while(bytes > 0)
+        {
+            const ssize_t written{ ::send(fd, data, bytes, MSG_NOSIGNAL) };
+            if(written <= 0)
+                return false;
+            data += written;
+            bytes -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    bool readAll(int fd, std::byte* data, std::size_t bytes)
+    {
+        while(bytes > 0)
+        {
+            const ssize_t got{ ::recv(fd, data, bytes, 0) };
+            if(got <= 0)
+                return false;
+            data += got;
+            bytes -= static_cast<std::size_t>(got);
+        }
+        return true;
+    }
+
+    struct Frame
+    {
+        int         source{};
+        int         destination{};
+        MessageType type{};
+        std::vector<std::byte> payload{};
+    };
+
+    /// @return false on a closed connection or a frame announcing more than maxPayload bytes
+    bool readFrame(int fd, Frame& frame, std::size_t maxPayload)
+    {
+        std::array<std::byte, headerSize> header{};
+        if(!readAll(fd, header.data(), header.size()))
+            return false;
+
+        // O tamanho vem do outro lado da conexão: nada além do maior registro de migrantes é alocado
+        const std::size_t length{ getU32(header.data()) };
+        if(length > maxPayload)
+            return false;
+
+        frame.payload.resize(length);
+        frame.source      = static_cast<int>(getU32(header.data() + 4));
+        frame.destination = static_cast<int>(getU32(header.data() + 8));
+        frame.type        = static_cast<MessageType>(getU32(header.data() + 12));
+
+        return readAll(fd, frame.payload.data(), frame.payload.size());
+    }
+
+    /// @brief Opens a socket for `address`, either bound and listening (hub) or connected (island).
+    int openSocket(TransportType type, const std::string& address, bool listen)
+    {
+        if(type == TransportType::unix_socket)
+        {
+            sockaddr_un local{};
+            local.sun_family = AF_UNIX;
+            if(address.size() >= sizeof(local.sun_path))
+                throw std::invalid_argument("Unix socket path too long: " + address);
+            std::memcpy(local.sun_path, address.c_str(), address.size() + 1);
+
+            const int fd{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+            if(listen)
+            {
+                ::unlink(address.c_str());
+                if(::bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0 || ::listen(fd, SOMAXCONN) != 0)
+                    throw std::runtime_error("Unable to listen on " + address);
+                return fd;
+            }
+
+            if(::connect(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0)
+            {
+                ::close(fd);
+                return -1;
+            }
+            return fd;
+        }
+
+        const std::size_t colon{ address.rfind(':') };
+        if(colon == std::string::npos)
+            throw std::invalid_argument("TCP address must be host:port, got " + address);
+
+        const std::string host{ address.substr(0, colon) };
+        const std::string port{ address.substr(colon + 1) };
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = listen ? AI_PASSIVE : 0;
+
+        addrinfo* result{ nullptr };
+        if(::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result) != 0)
+            throw std::invalid_argument("Unable to resolve " + address);
+
+        int fd{ -1 };
+        for(addrinfo* it {result}; it && fd < 0; it = it->ai_next)
+        {
+            fd = ::socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+            if(fd < 0)
+                continue;
+
+            const int yes{ 1 };
+            bool ok{ false };
+
+            if(listen)
+            {
+                ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+                ok = ::bind(fd, it->ai_addr, it->ai_addrlen) == 0 && ::listen(fd, SOMAXCONN) == 0;
+            }
+            else
+                ok = ::connect(fd, it->ai_addr, it->ai_addrlen) == 0;
+
+            if(ok)
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+            else
+            {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+        ::freeaddrinfo(result);
+
+        if(listen && fd < 0)
+            throw std::runtime_error("Unable to listen on " + address);
+
+        return fd;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+SocketTransport::SocketTransport(TransportType type, const std::string& address, int rank, int size, std::size_t maxPayload)
+    : m_rank{ rank }, m_size{ size }, m_maxPayload{ maxPayload }
+{
+    if(rank < 0 || rank >= size)
+        throw std::invalid_argument("island_rank must be in [0, islands).");
+
+    if(rank == 0)
+    {
+        if(type == TransportType::unix_socket)
+            m_unixPath = address;
+
+        m_listenFd = openSocket(type, address, true);
+        m_peers.resize(static_cast<std::size_t>(size));
+        for(auto& peer : m_peers)
+            peer = std::make_unique<Peer>();
+
+        // Espera todas as ilhas se conectarem; cada uma se apresenta com um frame vazio
+        for(int connected {1}; connected < size; ++connected)
+        {
+            const int fd{ ::accept(m_listenFd, nullptr, nullptr) };
+            Frame hello{};
+
+            if(fd < 0 || !readFrame(fd, hello, m_maxPayload) || hello.source <= 0 || hello.source >= size || m_peers[hello.source]->fd >= 0)
+                throw std::runtime_error("Invalid island connection on " + address);
+
+            m_peers[hello.source]->fd = fd;
+        }
+    }
+    else
+    {
+        int fd{ -1 };
+        for(int attempt {0}; attempt < connectAttempts && fd < 0; ++attempt)
+        {
+            fd = openSocket(type, address, false);
+            if(fd < 0)
+                std::this_thread::sleep_for(retryDelay);
+        }
+
+        if(fd < 0)
+            throw std::runtime_error("Unable to reach the coordinator at " + address);
+
+        m_peers.push_back(std::make_unique<Peer>());
+        m_peers[0]->fd = fd;
+        writeFrame(*m_peers[0], m_rank, 0, MessageType::best, {}); // apresentação: só o rank de origem importa
+    }
+
+    m_receiver = std::thread{ &SocketTransport::receiveLoop, this };
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+SocketTransport::~SocketTransport()
+{
+    m_running = false;
+    if(m_receiver.joinable())
+        m_receiver.join();
+
+    for(auto& peer : m_peers)
+    {
+        if(peer->fd >= 0)
+            ::close(peer->fd);
+    }
+
+    if(m_listenFd >= 0)
+        ::close(m_listenFd);
+    if(!m_unixPath.empty())
+        ::unlink(m_unixPath.c_str());
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void SocketTransport::send(int destination, MessageType type, const std::vector<std::byte>& payload)
+{
+    if(destination == m_rank)
+    {
+        std::lock_guard lock{ m_inboxMtx };
+        m_inbox.push_back(Message{ m_rank, type, payload });
+        return;
+    }
+
+    // Fora do hub tudo passa pelo rank 0, que repassa ao destino
+    Peer& peer{ m_rank == 0 ? *m_peers.at(static_cast<std::size_t>(destination)) : *m_peers[0] };
+    writeFrame(peer, m_rank, destination, type, payload);
+}
+
+std::optional<Message> SocketTransport::poll()
+{
+    std::lock_guard lock{ m_inboxMtx };
+
+    if(m_inbox.empty())
+        return std::nullopt;
+
+    Message message{ std::move(m_inbox.front()) };
+    m_inbox.pop_front();
+    return message;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void SocketTransport::writeFrame(Peer& peer, int source, int destination, MessageType type, const std::vector<std::byte>& payload)
+{
+    std::array<std::byte, headerSize> header{};
+    putU32(header.data(),      static_cast<std::uint32_t>(payload.size()));
+    putU32(header.data() + 4,  static_cast<std::uint32_t>(source));
+    putU32(header.data() + 8,  static_cast<std::uint32_t>(destination));
+    putU32(header.data() + 12, static_cast<std::uint32_t>(type));
+
+    std::lock_guard lock{ peer.writeMtx };
+
+    // Ilha que já terminou e fechou a conexão: a mensagem é descartada
+    if(peer.fd >= 0 && writeAll(peer.fd, header.data(), header.size()))
+        writeAll(peer.fd, payload.data(), payload.size());
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void SocketTransport::receiveLoop()
+{
+    constexpr int pollTimeoutMs{ 100 };
+
+    std::vector<pollfd> fds{};
+    std::vector<std::size_t> owners{};
+
+    while(m_running)
+    {
+        fds.clear();
+        owners.clear();
+        for(std::size_t i {0}; i < m_peers.size(); ++i)
+        {
+            if(m_peers[i]->fd >= 0)
+            {
+                fds.push_back(pollfd{ m_peers[i]->fd, POLLIN, 0 });
+                owners.push_back(i);
+            }
+        }
+
+        if(fds.empty() || ::poll(fds.data(), fds.size(), pollTimeoutMs) <= 0)
+        {
+            if(fds.empty())
+                std::this_thread::sleep_for(std::chrono::milliseconds{ pollTimeoutMs });
+            continue;
+        }
+
+        for(std::size_t k {0}; k < fds.size(); ++k)
+        {
+            if(!(fds[k].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+
+            Peer& peer{ *m_peers[owners[k]] };
+            Frame frame{};
+
+            if(!readFrame(peer.fd, frame, m_maxPayload))
+            {
+                {
+                    std::lock_guard lock{ peer.writeMtx };
+                    ::close(peer.fd);
+                    peer.fd = -1;
+                }
+
+                // No hub, uma ilha desconectada conta como terminada para o coordenador não esperar por ela
+                if(m_rank == 0)
+                {
+                    std::lock_guard lock{ m_inboxMtx };
+                    m_inbox.push_back(Message{ static_cast<int>(owners[k]), MessageType::done, {} });
+                }
+                continue;
+            }
+
+            if(frame.destination == m_rank)
+            {
+                std::lock_guard lock{ m_inboxMtx };
+                m_inbox.push_back(Message{ frame.source, frame.type, std::move(frame.payload) });
+            }
+            else if(m_rank == 0 && frame.destination > 0 && frame.destination < m_size)
+                writeFrame(*m_peers[static_cast<std::size_t>(frame.destination)], frame.source, frame.destination, frame.type, frame.payload);
+        }
+    }
+}
+
+#else
+
+SocketTransport::SocketTransport(TransportType, const std::string&, int, int, std::size_t)
+    : m_rank{ 0 }, m_size{ 1 }, m_maxPayload{ 0 }
+{
+    throw std::runtime_error("Socket transport is not available on this platform.");
+}
+
+SocketTransport::~SocketTransport() = default;
+void SocketTransport::send(int, MessageType, const std::vector<std::byte>&) {}
+std::optional<Message> SocketTransport::poll() { return std::nullopt; }
+void SocketTransport::writeFrame(Peer&, int, int, MessageType, const std::vector<std::byte>&) {}
+void SocketTransport::receiveLoop() {}
+
+#endif
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "constants.h"
+
+// Message passing between islands of the distributed island model.
+// Rank 0 hosts the coordinator; with sockets it also relays every message between the other ranks.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Enum para representar o tipo de mensagem entre ilhas
+enum class MessageType : std::uint32_t {
+    migrants,   // registros gene/fitness para a próxima ilha do anel
+    best,       // melhor atual de uma ilha, para o coordenador
+    done,       // ilha terminou; carrega o melhor final
+    stop        // coordenador pede que todas as ilhas parem
+};
+
+struct Message
+{
+    int                    source{};
+    MessageType            type{};
+    std::vector<std::byte> payload{};
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Asynchronous, unordered-between-sources message channel between the `size()` ranks of a run.
+class Transport
+{
+public:
+    virtual ~Transport() = default;
+
+    virtual int                    rank() const = 0;
+    virtual int                    size() const = 0;
+    virtual void                   send(int destination, MessageType type, const std::vector<std::byte>& payload) = 0;
+
+    /// @brief Non-blocking receive; empty when nothing is waiting.
+    virtual std::optional<Message> poll() = 0;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Mailboxes shared by the in-process islands of a LoopbackTransport.
+class LoopbackHub
+{
+public:
+    explicit LoopbackHub(int size) : m_boxes(static_cast<std::size_t>(size)) {}
+
+    int                    size() const { return static_cast<int>(m_boxes.size()); }
+    void                   push(int destination, Message message);
+    std::optional<Message> pop(int rank);
+
+private:
+    struct Mailbox
+    {
+        std::mutex          mtx{};
+        std::deque<Message> queue{};
+    };
+
+    std::vector<Mailbox> m_boxes;
+};
+
+/// @brief Islands running as threads of one process; used for local runs and as a stand-in for the sockets.
+class LoopbackTransport final : public Transport
+{
+public:
+    LoopbackTransport(LoopbackHub& hub, int rank) : m_hub{ hub }, m_rank{ rank } {}
+
+    int                    rank() const override { return m_rank; }
+    int                    size() const override { return m_hub.size(); }
+    void                   send(int destination, MessageType type, const std::vector<std::byte>& payload) override;
+    std::optional<Message> poll() override { return m_hub.pop(m_rank); }
+
+private:
+    LoopbackHub& m_hub;
+    int          m_rank;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Star topology over TCP or Unix domain sockets: every rank connects to rank 0, which relays.
+///
+/// Frames are a fixed little-endian header (payload length, source, destination, type) followed by the
+/// payload. A background thread per process reads frames into the inbox (and, on rank 0, forwards them).
+/// A frame announcing more than `maxPayload` bytes is a protocol error and drops the connection, so a
+/// broken or hostile peer cannot make the reader allocate an arbitrary length.
+class SocketTransport final : public Transport
+{
+public:
+    /// @param address "host:port" for TCP, a filesystem path for Unix sockets
+    /// @param maxPayload largest payload accepted from a peer (IslandLink::payloadLimit)
+    SocketTransport(TransportType type, const std::string& address, int rank, int size, std::size_t maxPayload);
+    ~SocketTransport() override;
+
+    SocketTransport(const SocketTransport&) = delete;
+    SocketTransport& operator=(const SocketTransport&) = delete;
+
+    int                    rank() const override { return m_rank; }
+    int                    size() const override { return m_size; }
+    void                   send(int destination, MessageType type, const std::vector<std::byte>& payload) override;
+    std::optional<Message> poll() override;
+
+private:
+    struct Peer
+    {
+        int        fd{ -1 };
+        std::mutex writeMtx{};
+    };
+
+    void writeFrame(Peer& peer, int source, int destination, MessageType type, const std::vector<std::byte>& payload);
+    void receiveLoop();
+
+    int                                m_rank;
+    int                                m_size;
+    std::size_t                        m_maxPayload;
+    std::string                        m_unixPath{};
+    int                                m_listenFd{ -1 };
+    std::vector<std::unique_ptr<Peer>> m_peers{};   // rank 0: one per rank; others: only the hub at index 0
+    std::mutex                         m_inboxMtx{};
+    std::deque<Message>                m_inbox{};
+    std::atomic<bool>                  m_running{ true };
+    std::thread                        m_receiver{};
+};
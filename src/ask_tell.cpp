@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include "gao.h"
+#include "breeding.h"
+#include "crossover.h"
+#include "genetic_operators.h"
+#include "MutationSchedule.h"
+#include "Random.h"
+#include "SearchBounds.h"
+
+// The GA generation step of createNewGeneration, split at the evaluation: ask() breeds the children,
+// tell() fills in their fitness and finishes the generation.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace gao {
+
+    namespace {
+
+        /// @brief Lends an optimizer's engine to Random::mt, which the GA operators draw from, and gives the
+        /// calling thread's engine back at the end of the scope.
+        class EngineScope
+        {
+        public:
+            explicit EngineScope(std::mt19937& engine) : m_engine{ engine } { std::swap(Random::mt, m_engine); }
+            ~EngineScope() { std::swap(Random::mt, m_engine); }
+
+            EngineScope(const EngineScope&) = delete;
+            EngineScope& operator=(const EngineScope&) = delete;
+
+        private:
+            std::mt19937& m_engine;
+        };
+
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    struct Optimizer::State
+    {
+        State(const Parameters& params, SearchBounds searchBounds)
+            : p{ params }, bounds{ std::move(searchBounds) },
+              rng{ params.seed != 0 ? Random::stream(params.seed, 0) : Random::generate() }
+        {
+            if(bounds.size() == 0)
+                throw std::invalid_argument("The search box needs at least one dimension.");
+            if(p.pop_size < 2)
+                throw std::invalid_argument("pop_size must be at least 2.");
+            if(p.elite_fraction < 0.0 || p.elite_fraction >= 1.0)
+                throw std::invalid_argument("elite_fraction must be in [0, 1).");
+
+            p.dimensions = static_cast<int>(bounds.size());
+            numElites = std::min(p.pop_size - 1, std::max(1, static_cast<int>(p.elite_fraction * p.pop_size)));
+            settings = CrossoverSettings::from(p, bounds);
+        }
+
+        Parameters              p;
+        SearchBounds            bounds;
+        std::mt19937            rng;                // sorteios deste otimizador, independentes da thread que chama ask()
+        CrossoverSettings       settings{};
+        RunState                state{};
+        int                     numElites{};
+
+        Population<double>      population{};
+        Population<double>      next{};
+        std::vector<double>     batch{};
+        std::vector<double>     fitness{};          // geração atual, para a seleção
+        std::vector<double>     parentFitness{};    // melhor dos pais de cada filho, para a regra de 1/5
+        std::vector<MatingPair> pairs{};
+        ParentSelector          select{};
+        BasicChromosome<double> spare{};
+
+        bool                    initialized{ false };
+        bool                    pending{ false };
+        int                     generation{ 0 };
+
+        void breed();
+        void copyRows(const Population<double>& source, int begin, int end);
+    };
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    void Optimizer::State::copyRows(const Population<double>& source, int begin, int end)
+    {
+        const std::size_t n{ bounds.size() };
+        batch.resize(static_cast<std::size_t>(end - begin) * n);
+
+        for(int i {begin}; i < end; ++i)
+            std::copy_n(source[i].get_genes_array().data(), n, batch.data() + static_cast<std::size_t>(i - begin) * n);
+    }
+
+    /// @brief Elites, selection, crossover and mutation of one generation, without evaluating anyone.
+    void Optimizer::State::breed()
+    {
+        state.generation = generation;
+        updateMutationSchedule(p, state);
+
+        next.resize(p.pop_size);
+        std::copy(population.begin(), population.begin() + numElites, next.begin());
+
+        fitness.resize(population.size());
+        for(std::size_t i {0}; i < population.size(); ++i)
+            fitness[i] = population[i].get_fitness();
+
+        const int children{ p.pop_size - numElites };
+        pairs.resize(static_cast<std::size_t>(children + 1) / 2);
+
+        select.prepare(std::span<const double>(fitness), p.method, tournamentSize(p));
+        select.drawPairs(std::span<MatingPair>(pairs));
+
+        crossoverBatch(population, std::span<const MatingPair>(pairs), next.data() + numElites, static_cast<std::size_t>(children), p.points, settings, spare);
+
+        parentFitness.resize(static_cast<std::size_t>(children));
+        for(int c {0}; c < children; ++c)
+        {
+            const MatingPair& pair{ pairs[static_cast<std::size_t>(c) / 2] };
+            parentFitness[c] = std::min(fitness[pair.first], fitness[pair.second]);
+
+            BasicChromosome<double>& child{ next[numElites + c] };
+            if(child.mutate(state.mutation_rate, state.mutation_strength))
+                child.checkBounds(bounds);
+        }
+
+        copyRows(next, numElites, p.pop_size);
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    Optimizer::Optimizer(const Parameters& p)
+        : m_state{ std::make_unique<State>(p, SearchBounds{ p.target_function, p.dimensions, p.boundary_handling }) }
+    {
+    }
+
+    Optimizer::Optimizer(const Parameters& p, std::vector<double> lower, std::vector<double> upper)
+        : m_state{ std::make_unique<State>(p, SearchBounds{ std::move(lower), std::move(upper), p.boundary_handling }) }
+    {
+    }
+
+    Optimizer::~Optimizer() = default;
+    Optimizer::Optimizer(Optimizer&&) noexcept = default;
+    Optimizer& Optimizer::operator=(Optimizer&&) noexcept = default;
+
+    std::size_t Optimizer::dimensions() const
+    {
+        return m_state->bounds.size();
+    }
+
+    std::size_t Optimizer::batchSize() const
+    {
+        const State& s{ *m_state };
+        return static_cast<std::size_t>(s.initialized ? s.p.pop_size - s.numElites : s.p.pop_size);
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    std::span<const double> Optimizer::ask()
+    {
+        State& s{ *m_state };
+
+        if(!s.pending)
+        {
+            const EngineScope engine{ s.rng };
+
+            if(s.initialized)
+                s.breed();
+            else
+            {
+                s.population = initialization<double>(s.bounds, s.p.pop_size, s.p.init_sampling);
+                s.copyRows(s.population, 0, s.p.pop_size);
+            }
+
+            s.pending = true;
+        }
+
+        return s.batch;
+    }
+
+    void Optimizer::tell(std::span<const double> fitness)
+    {
+        State& s{ *m_state };
+
+        if(!s.pending)
+            throw std::invalid_argument("tell() without a preceding ask().");
+        if(fitness.size() != batchSize())
+            throw std::invalid_argument("tell() needs one fitness value per genome of the last ask().");
+
+        // NaN quebraria a ordenação da população: avaliação falha vale a pior fitness
+        const auto score{ [fitness](std::size_t i) {
+            return std::isnan(fitness[i]) ? std::numeric_limits<double>::infinity() : fitness[i];
+        } };
+
+        if(!s.initialized)
+        {
+            for(std::size_t i {0}; i < fitness.size(); ++i)
+                s.population[i].set_fitness(score(i));
+
+            s.initialized = true;
+        }
+        else
+        {
+            int successes{ 0 };
+            for(std::size_t c {0}; c < fitness.size(); ++c)
+            {
+                s.next[s.numElites + c].set_fitness(score(c));
+                successes += score(c) < s.parentFitness[c];
+            }
+
+            s.state.mutation_attempts = static_cast<int>(fitness.size());
+            s.state.mutation_successes = successes;
+
+            s.population.swap(s.next);
+            ++s.generation;
+        }
+
+        std::sort(s.population.begin(), s.population.end());
+        s.pending = false;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    int Optimizer::generation() const
+    {
+        return m_state->generation;
+    }
+
+    std::span<const double> Optimizer::bestGenes() const
+    {
+        const State& s{ *m_state };
+        return s.initialized ? s.population[BEST_SOLUTION].genes() : std::span<const double>{};
+    }
+
+    double Optimizer::bestFitness() const
+    {
+        const State& s{ *m_state };
+        return s.initialized ? s.population[BEST_SOLUTION].get_fitness() : std::numeric_limits<double>::infinity();
+    }
+
+    bool Optimizer::done() const
+    {
+        const State& s{ *m_state };
+        return s.generation >= s.p.nIterations || (s.p.stop_at_fitness && bestFitness() <= s.p.stop_fitness);
+    }
+
+}
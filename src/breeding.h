@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+#include "constants.h"
+#include "crossover.h"
+#include "PerfCounters.h"
+
+// Generation step shared by the GA over BasicChromosome (breedRange) and over FixedChromosome (fixedGenomeGA).
+// Parents are drawn through a ParentSelector prepared once per generation, and every block of children goes
+// through breedBlock. What depends on the genome layout (crossover kernel, mutation with repair, batch
+// evaluation) comes in through an operator set, so the pipeline itself exists once for both chromosome types.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Parent draws over one generation. Tournaments run over a copy of the fitness column; the roulette
+/// methods build their cumulative distribution once and every draw is a binary search.
+class ParentSelector
+{
+public:
+    /// @brief `fitness` is the selection fitness of every individual, in population order (sorted by raw fitness).
+    ///
+    /// Sharing and clearing may rewrite it out of that order: ranking then ranks by it, and fps leaves the
+    /// individuals clearing pushed to the maximum fitness out of the roulette.
+    void prepare(std::span<const double> fitness, SelectionMethod method, int tournamentSize);
+
+    void draw(std::span<int> winners) const;
+    void drawPairs(std::span<MatingPair> pairs) const;
+
+private:
+    SelectionMethod     m_method{};
+    int                 m_tournamentSize{ 3 };
+    std::vector<double> m_weights{};   // fitness (torneio) ou distribuição acumulada (roleta)
+    std::vector<int>    m_order{};     // índice de cada posição do ranking, quando a fitness está fora de ordem
+    double              m_total{};
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Fills children[0, count) in place: selection, crossover, mutation of a copy of every child, one
+/// evaluation batch for children and copies, then the better of each child and its copy keeps the slot.
+///
+/// `pairs` receives the (count + 1) / 2 mating pairs of the block. For a chromosome type C, `Operators` provides:
+///   crossover(std::span<const MatingPair>, C* children, std::size_t count)   children of pair k into slots 2k and 2k + 1
+///   mutate(C& mutant, const C& child) -> bool                                 mutated and repaired copy; false if no gene changed
+///   evaluate(std::span<C* const>)                                             fitness of a batch of rows
+/// @return number of mutated copies that replaced their child
+template <typename C, typename Operators>
+int breedBlock(const ParentSelector& select, const Operators& operators, std::span<MatingPair> pairs, C* children, std::size_t count)
+{
+    thread_local std::vector<C> mutants{};
+    thread_local std::vector<char> mutated{};
+    thread_local std::vector<C*> batch{};
+
+    {
+        const PhaseScope scope{ GaPhase::selection, count };
+        select.drawPairs(pairs);
+    }
+
+    {
+        const PhaseScope scope{ GaPhase::crossover, count };
+        operators.crossover(std::span<const MatingPair>(pairs), children, count);
+    }
+
+    mutants.resize(count);
+    mutated.resize(count);
+
+    {
+        const PhaseScope scope{ GaPhase::mutation, count };
+        for(std::size_t i {0}; i < count; ++i)
+            mutated[i] = operators.mutate(mutants[i], children[i]);
+    }
+
+    {
+        const PhaseScope scope{ GaPhase::evaluation, count };
+
+        // Cópia sem nenhum gene alterado é idêntica ao filho e não é avaliada
+        batch.clear();
+        for(std::size_t i {0}; i < count; ++i)
+        {
+            batch.push_back(children + i);
+            if(mutated[i])
+                batch.push_back(&mutants[i]);
+        }
+
+        operators.evaluate(std::span<C* const>(batch));
+    }
+
+    int successes{ 0 };
+    for(std::size_t i {0}; i < count; ++i)
+    {
+        if(mutated[i] && mutants[i].get_fitness() < children[i].get_fitness())
+        {
+            std::swap(children[i], mutants[i]);
+            ++successes;
+        }
+    }
+
+    return successes;
+}
@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <omp.h>
+#include "engines.h"
+#include "genetic_operators.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    /// @brief Cyclic Jacobi eigen decomposition of a symmetric row-major n x n matrix.
+    /// @param a matrix to decompose (taken by value, it is reduced to diagonal form)
+    /// @param eigenvalues receives the n eigenvalues
+    /// @param vectors receives the eigenvectors as columns (row-major n x n)
+    void jacobiEigen(std::vector<double> a, int n, std::vector<double>& eigenvalues, std::vector<double>& vectors)
+    {
+        vectors.assign(static_cast<std::size_t>(n) * n, 0.0);
+        for(int i {0}; i < n; ++i)
+            vectors[i * n + i] = 1.0;
+
+        for(int sweep {0}; sweep < 64; ++sweep)
+        {
+            double offDiagonal{ 0.0 };
+            double diagonal{ 0.0 };
+
+            for(int i {0}; i < n; ++i)
+            {
+                diagonal += a[i * n + i] * a[i * n + i];
+                for(int j {i + 1}; j < n; ++j)
+                    offDiagonal += a[i * n + j] * a[i * n + j];
+            }
+
+            if(offDiagonal <= 1e-30 * diagonal)
+                break;
+
+            for(int p {0}; p < n - 1; ++p)
+            {
+                for(int q {p + 1}; q < n; ++q)
+                {
+                    const double apq{ a[p * n + q] };
+                    if(std::abs(apq) < 1e-300)
+                        continue;
+
+                    const double theta{ (a[q * n + q] - a[p * n + p]) / (2.0 * apq) };
+                    const double t{ std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0)) };
+                    const double c{ 1.0 / std::sqrt(t * t + 1.0) };
+                    const double s{ t * c };
+
+                    for(int k {0}; k < n; ++k)
+                    {
+                        const double akp{ a[k * n + p] };
+                        const double akq{ a[k * n + q] };
+                        a[k * n + p] = c * akp - s * akq;
+                        a[k * n + q] = s * akp + c * akq;
+                    }
+
+                    for(int k {0}; k < n; ++k)
+                    {
+                        const double apk{ a[p * n + k] };
+                        const double aqk{ a[q * n + k] };
+                        a[p * n + k] = c * apk - s * aqk;
+                        a[q * n + k] = s * apk + c * aqk;
+                    }
+
+                    for(int k {0}; k < n; ++k)
+                    {
+                        const double vkp{ vectors[k * n + p] };
+                        const double vkq{ vectors[k * n + q] };
+                        vectors[k * n + p] = c * vkp - s * vkq;
+                        vectors[k * n + q] = s * vkp + c * vkq;
+                    }
+                }
+            }
+        }
+
+        eigenvalues.resize(n);
+        for(int i {0}; i < n; ++i)
+            eigenvalues[i] = a[i * n + i];
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief (mu/mu_w, lambda)-CMA-ES following Hansen's tutorial formulation.
+///
+/// lambda comes from cma_lambda, falling back to the default 4 + 3 ln n (pop_size is not used,
+/// CMA-ES needs far smaller populations than the GA). The rank-mu update is computed as dot products over a
+/// transposed, weight-scaled selection matrix so that the inner loop is contiguous.
+RunResult covarianceMatrixAdaptation(const Parameters& p, int numThreads, bool parallel)
+{
+    const SearchBounds bounds{ p.target_function, p.dimensions, p.boundary_handling };
+    const int n{ static_cast<int>(bounds.size()) };
+    const double dn{ static_cast<double>(n) };
+
+    const int lambda{ p.cma_lambda > 0 ? p.cma_lambda : 4 + static_cast<int>(3.0 * std::log(dn)) };
+    const int mu{ std::max(1, lambda / 2) };
+
+    // Pesos de recombinação
+    std::vector<double> weights(mu);
+    for(int i {0}; i < mu; ++i)
+        weights[i] = std::log(mu + 0.5) - std::log(i + 1.0);
+
+    const double weightSum{ std::accumulate(weights.begin(), weights.end(), 0.0) };
+    for(double& w : weights)
+        w /= weightSum;
+
+    const double mueff{ 1.0 / std::inner_product(weights.begin(), weights.end(), weights.begin(), 0.0) };
+
+    // Parâmetros de adaptação
+    const double cc    { (4.0 + mueff / dn) / (dn + 4.0 + 2.0 * mueff / dn) };
+    const double cs    { (mueff + 2.0) / (dn + mueff + 5.0) };
+    const double c1    { 2.0 / ((dn + 1.3) * (dn + 1.3) + mueff) };
+    const double cmu   { std::min(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((dn + 2.0) * (dn + 2.0) + mueff)) };
+    const double damps { 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff - 1.0) / (dn + 1.0)) - 1.0) + cs };
+    const double chiN  { std::sqrt(dn) * (1.0 - 1.0 / (4.0 * dn) + 1.0 / (21.0 * dn * dn)) };
+
+    std::vector<double> mean(n);
+    double sigma{ 0.0 };
+    for(int i {0}; i < n; ++i)
+    {
+        mean[i] = Random::get(bounds.lower(i), bounds.upper(i));
+        sigma += 0.3 * (bounds.upper(i) - bounds.lower(i)) / dn;
+    }
+
+    std::vector<double> C(n * n, 0.0), B(n * n, 0.0), D(n, 1.0);
+    for(int i {0}; i < n; ++i)
+        C[i * n + i] = B[i * n + i] = 1.0;
+
+    std::vector<double> pc(n, 0.0), ps(n, 0.0), oldMean(n), yw(n), tmp(n), z(n), x(n);
+    std::vector<double> selected(static_cast<std::size_t>(n) * mu);   // n x mu, pesos já aplicados
+    std::vector<Chromosome> samples(lambda);
+    std::vector<int> order(lambda);
+    std::normal_distribution<> gauss(0.0, 1.0);
+
+    Chromosome best{};
+    bool hasBest{ false };
+    int eigenGeneration{ 0 };
+    const int eigenInterval{ std::max(1, static_cast<int>(lambda / ((c1 + cmu) * dn * 10.0))) };
+    int generations{ p.nIterations };
+    StopReason stop{ StopReason::iterations };
+    const int chunk{ p.parallel_chunk > 0 ? p.parallel_chunk : std::max(1, lambda / std::max(1, numThreads)) };
+
+    ConvergenceTrace trace{ p.trace_length };
+    PopulationMoments moments{};
+
+    for(int generation {0}; generation < p.nIterations; ++generation)
+    {
+        // Amostragem: x = m + sigma * B * D * z
+        for(int k {0}; k < lambda; ++k)
+        {
+            for(int i {0}; i < n; ++i)
+                z[i] = D[i] * gauss(Random::mt);
+
+            for(int i {0}; i < n; ++i)
+            {
+                double acc{ 0.0 };
+                for(int j {0}; j < n; ++j)
+                    acc += B[i * n + j] * z[j];
+                x[i] = mean[i] + sigma * acc;
+            }
+
+            bounds.repair(x);
+            samples[k] = Chromosome(x);
+        }
+
+        #pragma omp parallel for schedule(dynamic, chunk) num_threads(numThreads) if(parallel)
+        for(int k = 0; k < lambda; ++k)
+            samples[k].evaluate_solution(p.target_function);
+
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&samples](int a, int b) { return samples[a] < samples[b]; });
+
+        if(!hasBest || samples[order[0]] < best)
+        {
+            best = samples[order[0]];
+            hasBest = true;
+        }
+
+        if(trace.enabled())
+        {
+            moments.reset(static_cast<std::size_t>(n));
+            for(const Chromosome& sample : samples)
+                moments.add(sample.genes(), sample.get_fitness());
+
+            trace.record(moments.stats(generation, GenerationStats::notApplicable, sigma));
+        }
+
+        // Atualização da média
+        oldMean = mean;
+        std::fill(mean.begin(), mean.end(), 0.0);
+        for(int k {0}; k < mu; ++k)
+        {
+            const auto& genes{ samples[order[k]].get_genes_array() };
+            for(int i {0}; i < n; ++i)
+                mean[i] += weights[k] * genes[i];
+        }
+
+        for(int i {0}; i < n; ++i)
+            yw[i] = (mean[i] - oldMean[i]) / sigma;
+
+        // Caminho de evolução do passo: ps usa C^(-1/2) * yw = B * D^-1 * B^T * yw
+        for(int j {0}; j < n; ++j)
+        {
+            double acc{ 0.0 };
+            for(int i {0}; i < n; ++i)
+                acc += B[i * n + j] * yw[i];
+            tmp[j] = acc / D[j];
+        }
+
+        const double csFactor{ std::sqrt(cs * (2.0 - cs) * mueff) };
+        double psNorm{ 0.0 };
+        for(int i {0}; i < n; ++i)
+        {
+            double acc{ 0.0 };
+            for(int j {0}; j < n; ++j)
+                acc += B[i * n + j] * tmp[j];
+            ps[i] = (1.0 - cs) * ps[i] + csFactor * acc;
+            psNorm += ps[i] * ps[i];
+        }
+        psNorm = std::sqrt(psNorm);
+
+        const bool hsig{ psNorm / std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * (generation + 1))) / chiN < 1.4 + 2.0 / (dn + 1.0) };
+
+        const double ccFactor{ std::sqrt(cc * (2.0 - cc) * mueff) };
+        for(int i {0}; i < n; ++i)
+            pc[i] = (1.0 - cc) * pc[i] + (hsig ? ccFactor * yw[i] : 0.0);
+
+        // Matriz transposta das melhores amostras, escalada por sqrt(w): C_mu = Y^T * Y
+        for(int k {0}; k < mu; ++k)
+        {
+            const auto& genes{ samples[order[k]].get_genes_array() };
+            const double scale{ std::sqrt(weights[k]) / sigma };
+            for(int i {0}; i < n; ++i)
+                selected[i * mu + k] = scale * (genes[i] - oldMean[i]);
+        }
+
+        const double hsigCorrection{ hsig ? 0.0 : cc * (2.0 - cc) };
+
+        #pragma omp parallel for schedule(dynamic, 4) num_threads(numThreads) if(parallel && n >= 64)
+        for(int i = 0; i < n; ++i)
+        {
+            const double* rowI{ selected.data() + static_cast<std::size_t>(i) * mu };
+
+            for(int j = 0; j <= i; ++j)
+            {
+                const double* rowJ{ selected.data() + static_cast<std::size_t>(j) * mu };
+
+                double rankMu{ 0.0 };
+                #pragma omp simd reduction(+:rankMu)
+                for(int k = 0; k < mu; ++k)
+                    rankMu += rowI[k] * rowJ[k];
+
+                const double rankOne{ pc[i] * pc[j] + hsigCorrection * C[i * n + j] };
+                const double value{ (1.0 - c1 - cmu) * C[i * n + j] + c1 * rankOne + cmu * rankMu };
+
+                C[i * n + j] = value;
+                C[j * n + i] = value;
+            }
+        }
+
+        sigma *= std::exp((cs / damps) * (psNorm / chiN - 1.0));
+
+        if(generation - eigenGeneration >= eigenInterval)
+        {
+            eigenGeneration = generation;
+            jacobiEigen(C, n, D, B);
+
+            for(double& d : D)
+                d = std::sqrt(std::max(d, 1e-20));
+        }
+
+        const bool converged{ sigma * *std::max_element(D.begin(), D.end()) < 1e-12 };
+
+        if((generation + 1) % 100 == 0 || generation == p.nIterations - 1 || converged)
+            printSolution(best, generation);
+
+        if(converged)
+        {
+            generations = generation + 1;
+            stop = StopReason::converged;
+            break;
+        }
+    }
+
+    RunResult result{ best, CacheStats{}, generations, stop };
+    result.trace = trace.chronological();
+
+    return result;
+}
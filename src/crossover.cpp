@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "Random.h"
+#include "crossover.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    constexpr std::size_t maskBits{ 64 };
+
+    // Os kernels recebem n como std::size_t ou como std::integral_constant (FixedChromosome): no segundo caso
+    // o número de genes é uma constante e os laços são desenrolados
+
+    /// @brief Uniform crossover: one random 64-bit word decides 64 genes, applied as a branch-free blend.
+    template <typename T, typename Size>
+    void uniformKernel(const T* parent1, const T* parent2, T* child1, T* child2, Size n)
+    {
+        for(std::size_t base {0}; base < n; base += maskBits)
+        {
+            const std::uint64_t mask{ (static_cast<std::uint64_t>(Random::mt()) << 32) | Random::mt() };
+            const std::size_t count{ std::min(maskBits, n - base) };
+
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const bool swap{ ((mask >> i) & 1U) != 0 };
+                child1[base + i] = swap ? parent2[base + i] : parent1[base + i];
+                child2[base + i] = swap ? parent1[base + i] : parent2[base + i];
+            }
+        }
+    }
+
+    /// @brief One or two point crossover as contiguous segment copies.
+    template <typename T, typename Size>
+    void kPointKernel(const T* parent1, const T* parent2, T* child1, T* child2, Size n, int points)
+    {
+        const int size{ static_cast<int>(n) };
+
+        if(size < 2)
+        {
+            std::memcpy(child1, parent1, n * sizeof(T));
+            std::memcpy(child2, parent2, n * sizeof(T));
+            return;
+        }
+
+        std::size_t cut1{ static_cast<std::size_t>(Random::uniform(1, size)) };
+        std::size_t cut2{ n };
+
+        // Garante que os pontos são únicos e ordenados
+        if(points == 2 && size > 2)
+        {
+            cut2 = static_cast<std::size_t>(Random::uniform(1, size));
+            while(cut1 == cut2)
+                cut2 = static_cast<std::size_t>(Random::uniform(1, size));
+            if(cut1 > cut2)
+                std::swap(cut1, cut2);
+        }
+
+        std::memcpy(child1, parent1, cut1 * sizeof(T));
+        std::memcpy(child1 + cut1, parent2 + cut1, (cut2 - cut1) * sizeof(T));
+        std::memcpy(child1 + cut2, parent1 + cut2, (n - cut2) * sizeof(T));
+
+        std::memcpy(child2, parent2, cut1 * sizeof(T));
+        std::memcpy(child2 + cut1, parent1 + cut1, (cut2 - cut1) * sizeof(T));
+        std::memcpy(child2 + cut2, parent2 + cut2, (n - cut2) * sizeof(T));
+    }
+
+    /// @brief Whole arithmetic crossover: both children are complementary convex combinations.
+    template <typename T, typename Size>
+    void arithmeticKernel(const T* parent1, const T* parent2, T* child1, T* child2, Size n)
+    {
+        const T a{ static_cast<T>(Random::rand()) };
+        const T b{ T{ 1 } - a };
+
+        #pragma omp simd
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            child1[i] = a * parent1[i] + b * parent2[i];
+            child2[i] = b * parent1[i] + a * parent2[i];
+        }
+    }
+
+    // Números aleatórios de um par inteiro gerados antes do laço vetorizado, em [0, 1)
+    template <typename T>
+    const T* uniformDraws(std::size_t count)
+    {
+        thread_local std::vector<T> draws{};
+        draws.resize(count);
+
+        // Algumas bibliotecas padrão arredondam o sorteio para 1 (generate_canonical); o SBX divide por 1 - u
+        const T belowOne{ std::nextafter(T{ 1 }, T{ 0 }) };
+        std::mt19937& rng{ Random::mt };
+        std::uniform_real_distribution<T> unit(T{ 0 }, T{ 1 });
+        for(T& u : draws)
+            u = std::min(unit(rng), belowOne);
+
+        return draws.data();
+    }
+
+    /// @brief BLX-alpha: each child gene is drawn from the parents' interval widened by alpha on both sides.
+    template <typename T, typename Size>
+    void blxKernel(const T* parent1, const T* parent2, T* child1, T* child2, Size n, double alpha)
+    {
+        const T* u{ uniformDraws<T>(2 * n) };
+        const T a{ static_cast<T>(alpha) };
+        const T span{ T{ 1 } + 2 * a };
+
+        #pragma omp simd
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const T lo{ std::min(parent1[i], parent2[i]) };
+            const T d{ std::max(parent1[i], parent2[i]) - lo };
+            const T start{ lo - a * d };
+
+            child1[i] = start + u[i] * span * d;
+            child2[i] = start + u[n + i] * span * d;
+        }
+    }
+
+    /// @brief Simulated binary crossover (Deb): spread factor beta from a polynomial distribution of index eta.
+    template <typename T, typename Size>
+    void sbxKernel(const T* parent1, const T* parent2, T* child1, T* child2, Size n, double eta)
+    {
+        const T* u{ uniformDraws<T>(n) };
+        const T exponent{ static_cast<T>(1.0 / (eta + 1.0)) };
+
+        #pragma omp simd
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const T base{ u[i] <= T{ 0.5 } ? 2 * u[i] : T{ 1 } / (2 * (T{ 1 } - u[i])) };
+            const T beta{ std::pow(base, exponent) };
+
+            const T sum { parent1[i] + parent2[i] };
+            const T diff{ beta * (parent2[i] - parent1[i]) };
+
+            child1[i] = T{ 0.5 } * (sum - diff);
+            child2[i] = T{ 0.5 } * (sum + diff);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename Size>
+    void pairKernel(const T* parent1, const T* parent2, T* child1, T* child2, Size n, Points method, const CrossoverSettings& settings)
+    {
+        switch(method)
+        {
+            case Points::one:
+                kPointKernel(parent1, parent2, child1, child2, n, 1);
+                break;
+            case Points::two:
+                kPointKernel(parent1, parent2, child1, child2, n, 2);
+                break;
+            case Points::uniform:
+                uniformKernel(parent1, parent2, child1, child2, n);
+                break;
+            case Points::arithmetic:
+                arithmeticKernel(parent1, parent2, child1, child2, n);
+                break;
+            case Points::blx:
+                blxKernel(parent1, parent2, child1, child2, n, settings.blx_alpha);
+                break;
+            case Points::sbx:
+                sbxKernel(parent1, parent2, child1, child2, n, settings.sbx_eta);
+                break;
+        }
+
+        // Só BLX e SBX podem gerar genes fora dos limites
+        if(settings.bounds && (method == Points::blx || method == Points::sbx))
+        {
+            settings.bounds->repair(child1, n);
+            settings.bounds->repair(child2, n);
+        }
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+CrossoverSettings CrossoverSettings::from(const Parameters& p, const SearchBounds& bounds)
+{
+    CrossoverSettings settings{};
+    if(p.blx_alpha > 0.0)
+        settings.blx_alpha = p.blx_alpha;
+    if(p.sbx_eta > 0.0)
+        settings.sbx_eta = p.sbx_eta;
+    settings.bounds = &bounds;
+    return settings;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void crossoverPair(const T* parent1, const T* parent2, T* child1, T* child2, std::size_t n, Points method, const CrossoverSettings& settings)
+{
+    pairKernel(parent1, parent2, child1, child2, n, method, settings);
+}
+
+template <typename T, std::size_t N>
+void crossoverPair(const T* parent1, const T* parent2, T* child1, T* child2, Points method, const CrossoverSettings& settings)
+{
+    pairKernel(parent1, parent2, child1, child2, std::integral_constant<std::size_t, N>{}, method, settings);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void crossoverBatch(const Population<T>& parents, std::span<const MatingPair> pairs, BasicChromosome<T>* children, std::size_t count,
+                    Points method, const CrossoverSettings& settings, BasicChromosome<T>& spare)
+{
+    const std::size_t n{ parents[0].size() };
+
+    for(std::size_t k {0}; k < pairs.size(); ++k)
+    {
+        const std::size_t idx{ 2 * k };
+        if(idx >= count)
+            break;
+
+        std::vector<T>& firstGenes { children[idx].get_genes_array() };
+        std::vector<T>& secondGenes{ idx + 1 < count ? children[idx + 1].get_genes_array() : spare.get_genes_array() };
+
+        firstGenes.resize(n);
+        secondGenes.resize(n);
+
+        crossoverPair(parents[pairs[k].first].get_genes_array().data(), parents[pairs[k].second].get_genes_array().data(),
+                      firstGenes.data(), secondGenes.data(), n, method, settings);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template void crossoverPair<float>(const float*, const float*, float*, float*, std::size_t, Points, const CrossoverSettings&);
+template void crossoverPair<double>(const double*, const double*, double*, double*, std::size_t, Points, const CrossoverSettings&);
+template void crossoverBatch<float>(const Population<float>&, std::span<const MatingPair>, BasicChromosome<float>*, std::size_t, Points, const CrossoverSettings&, BasicChromosome<float>&);
+template void crossoverBatch<double>(const Population<double>&, std::span<const MatingPair>, BasicChromosome<double>*, std::size_t, Points, const CrossoverSettings&, BasicChromosome<double>&);
+
+// Uma linha por tamanho de fixedChromosomeSizes
+#define INSTANTIATE_FIXED_CROSSOVER(N) \
+    template void crossoverPair<float, N>(const float*, const float*, float*, float*, Points, const CrossoverSettings&); \
+    template void crossoverPair<double, N>(const double*, const double*, double*, double*, Points, const CrossoverSettings&);
+
+INSTANTIATE_FIXED_CROSSOVER(2)
+INSTANTIATE_FIXED_CROSSOVER(3)
+INSTANTIATE_FIXED_CROSSOVER(4)
+INSTANTIATE_FIXED_CROSSOVER(5)
+INSTANTIATE_FIXED_CROSSOVER(6)
+INSTANTIATE_FIXED_CROSSOVER(8)
+INSTANTIATE_FIXED_CROSSOVER(10)
+INSTANTIATE_FIXED_CROSSOVER(12)
+INSTANTIATE_FIXED_CROSSOVER(16)
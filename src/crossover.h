@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include "Chromosome.h"
+#include "Parameters.h"
+#include "SearchBounds.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Parent indices (in the previous generation) of one pair of children.
+struct MatingPair
+{
+    int first{};
+    int second{};
+};
+
+/// @brief Knobs of the real-valued operators.
+struct CrossoverSettings
+{
+    double              blx_alpha{ 0.5 };
+    double              sbx_eta{ 15.0 };
+    const SearchBounds* bounds{};          // repairs BLX/SBX children that leave the box
+
+    static CrossoverSettings from(const Parameters& p, const SearchBounds& bounds);
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Kernels over raw gene rows: no allocation, random draws made up front so the blend loops vectorize.
+template <typename T>
+void crossoverPair(const T* parent1, const T* parent2, T* child1, T* child2, std::size_t n, Points method, const CrossoverSettings& settings);
+/// @brief Same kernels for rows of exactly N genes (FixedChromosome), unrolled; instantiated for fixedChromosomeSizes.
+template <typename T, std::size_t N>
+void crossoverPair(const T* parent1, const T* parent2, T* child1, T* child2, Points method, const CrossoverSettings& settings);
+
+/// @brief Writes the children of every pair into children[0, count), two per pair.
+/// An odd count sends the second child of the last pair to `spare`.
+template <typename T>
+void crossoverBatch(const Population<T>& parents, std::span<const MatingPair> pairs, BasicChromosome<T>* children, std::size_t count,
+                    Points method, const CrossoverSettings& settings, BasicChromosome<T>& spare);
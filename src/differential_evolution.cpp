@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <memory>
+#include <omp.h>
+#include "engines.h"
+#include "genetic_operators.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    /// @brief Draws `count` distinct indices in [0, populationSize), all different from `exclude`.
+    template <std::size_t N>
+    std::array<int, N> distinctIndices(int populationSize, int exclude)
+    {
+        std::array<int, N> indices{};
+
+        for(std::size_t k {0}; k < N; ++k)
+        {
+            int candidate{};
+            do
+                candidate = Random::uniform(0, populationSize);
+            while(candidate == exclude || std::find(indices.begin(), indices.begin() + k, candidate) != indices.begin() + k);
+
+            indices[k] = candidate;
+        }
+
+        return indices;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Differential evolution, DE/rand/1/bin or DE/best/1/bin depending on p.engine.
+///
+/// Trial vectors are built serially (they consume the shared random stream) and then evaluated in parallel.
+RunResult differentialEvolution(const Parameters& p, int numThreads, bool parallel)
+{
+    if(p.pop_size < 4)
+        throw std::invalid_argument("Differential evolution needs pop_size >= 4.");
+
+    std::unique_ptr<FitnessCache> cache{ p.fitness_cache_size > 0 ? std::make_unique<FitnessCache>(p.fitness_cache_size) : nullptr };
+
+    const SearchBounds bounds{ p.target_function, p.dimensions, p.boundary_handling };
+    const bool bestBase{ p.engine == Engine::de_best_1_bin };
+    const double F { p.differential_weight > 0.0 ? p.differential_weight : 0.5 };
+    const double CR{ p.crossover_rate > 0.0 ? p.crossover_rate : 0.9 };
+
+    std::vector<Chromosome> population{ initialization(bounds, p.pop_size, p.init_sampling, parallel ? numThreads : 1) };
+    evaluatePopulation(population, p.target_function, cache.get());
+
+    const int dimensions{ static_cast<int>(bounds.size()) };
+    std::vector<Chromosome> trials(p.pop_size);
+    std::vector<double> trialGenes(dimensions);
+    const int chunk{ p.parallel_chunk > 0 ? p.parallel_chunk : std::max(1, p.pop_size / std::max(1, numThreads)) };
+
+    ConvergenceTrace trace{ p.trace_length };
+    PopulationMoments moments{};
+
+    int best{ static_cast<int>(std::min_element(population.begin(), population.end()) - population.begin()) };
+
+    for(int generation {0}; generation < p.nIterations; ++generation)
+    {
+        for(int i {0}; i < p.pop_size; ++i)
+        {
+            const auto [r1, r2, r3]{ distinctIndices<3>(p.pop_size, i) };
+
+            const auto& base  { population[bestBase ? best : r1].get_genes_array() };
+            const auto& diff1 { population[bestBase ? r1 : r2].get_genes_array() };
+            const auto& diff2 { population[bestBase ? r2 : r3].get_genes_array() };
+            const auto& target{ population[i].get_genes_array() };
+
+            // Cruzamento binomial: jRand garante ao menos um gene do vetor mutante
+            const int jRand{ Random::uniform(0, dimensions) };
+
+            for(int j {0}; j < dimensions; ++j)
+                trialGenes[j] = (j == jRand || Random::rand() < CR) ? base[j] + F * (diff1[j] - diff2[j]) : target[j];
+
+            bounds.repair(trialGenes);
+            trials[i] = Chromosome(trialGenes);
+        }
+
+        #pragma omp parallel for schedule(dynamic, chunk) num_threads(numThreads) if(parallel)
+        for(int i = 0; i < p.pop_size; ++i)
+            trials[i].evaluate_solution(p.target_function, cache.get());
+
+        if(trace.enabled())
+            moments.reset(static_cast<std::size_t>(dimensions));
+
+        for(int i {0}; i < p.pop_size; ++i)
+        {
+            if(trials[i].get_fitness() <= population[i].get_fitness())
+                std::swap(population[i], trials[i]);
+
+            if(population[i] < population[best])
+                best = i;
+
+            if(trace.enabled())
+                moments.add(population[i].genes(), population[i].get_fitness());
+        }
+
+        if(trace.enabled())
+            trace.record(moments.stats(generation, GenerationStats::notApplicable, GenerationStats::notApplicable));
+
+        if((generation + 1) % 100 == 0 || generation == p.nIterations - 1)
+            printSolution(population[best], generation);
+    }
+
+    RunResult result{ population[best], cache ? cache->stats() : CacheStats{}, p.nIterations, StopReason::iterations };
+    result.trace = trace.chronological();
+
+    return result;
+}
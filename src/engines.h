@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Parameters.h"
+#include "RunResult.h"
+
+// Optimizers selectable through the `engine` key of the config file.
+// All of them share the benchmark functions, SearchBounds and the multi-test runner in main.
+
+class IslandLink;
+
+// `island` connects the run to the distributed island model (migration every migration_interval generations)
+template <typename T>
+RunResult geneticAlgorithm(const Parameters& p, int numThreads, bool parallel, IslandLink* island = nullptr);
+RunResult differentialEvolution(const Parameters& p, int numThreads, bool parallel);
+RunResult covarianceMatrixAdaptation(const Parameters& p, int numThreads, bool parallel);
+
+// Multi-objective (objective_function); the Pareto front is returned in RunResult::pareto
+RunResult nsga2(const Parameters& p, int numThreads, bool parallel);
+
+// GA over a flat, chunked population store; always uses all `numThreads` inside the run
+template <typename T>
+RunResult largePopulationGA(const Parameters& p, int numThreads);
+
+// GA over FixedChromosome for the dimensions in fixedChromosomeSizes (FixedChromosome.h); any other dimension
+// runs geneticAlgorithm. fixedGenomeApplies says whether `p` can take this path (no surrogate, local search or niching)
+template <typename T>
+RunResult fixedGenomeGA(const Parameters& p, int numThreads, bool parallel);
+bool fixedGenomeApplies(const Parameters& p);
+
+// The engine of p.engine; for the GA, the variant main runs for these parameters (fixed genome, large
+// population, float/mixed precision). Benchmarks and the parallelism tuner go through it to time the real path
+RunResult runOptimizer(const Parameters& p, int numThreads, bool parallel, IslandLink* island = nullptr);
+
+void printSolution(const Chromosome& solution, int generation);
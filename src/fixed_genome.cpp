@@ -0,0 +1,413 @@
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <omp.h>
+#include "breeding.h"
+#include "crossover.h"
+#include "engines.h"
+#include "FixedChromosome.h"
+#include "genetic_operators.h"
+#include "MutationSchedule.h"
+#include "PerfCounters.h"
+#include "sampling.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    // Filhos produzidos por bloco: os filhos, as cópias mutadas e os ponteiros do lote ficam no L1/L2
+    constexpr std::size_t blockSize{ 256 };
+
+    // Mesmos blocos da inicialização da população em vetor, para a mesma semente dar a mesma população inicial
+    constexpr std::size_t initChunkSize{ 4096 };
+
+    constexpr std::size_t functionCount{ static_cast<std::size_t>(TargetFunction::max_functions) };
+
+    template <typename T, std::size_t D>
+    using RowEvaluator = void (*)(FixedChromosome<T, D>* const* rows, std::size_t count);
+
+    /// @brief Evaluates `count` rows with benchmark F called directly, so it is inlined with its loops unrolled.
+    template <typename T, std::size_t D, std::size_t F>
+    void evaluateRows(FixedChromosome<T, D>* const* rows, std::size_t count)
+    {
+        constexpr Benchmark::FixedFncPtr<T, D> fnc{ Benchmark::fixed_functions<T, D>[F] };
+
+        for(std::size_t i {0}; i < count; ++i)
+            rows[i]->fitness = fnc(rows[i]->view());
+    }
+
+    template <typename T, std::size_t D, std::size_t... F>
+    constexpr std::array<RowEvaluator<T, D>, sizeof...(F)> rowEvaluators(std::index_sequence<F...>)
+    {
+        return { evaluateRows<T, D, F>... };
+    }
+
+    /// @brief Fitness of a batch of rows: cache lookups first, then the misses go through the installed
+    /// transform or, without one, the unrolled benchmark picked once per run.
+    template <typename T, std::size_t D>
+    class FixedEvaluator
+    {
+    public:
+        FixedEvaluator(TargetFunction fnc, FitnessCache* cache)
+            : m_rows{ rowEvaluators<T, D>(std::make_index_sequence<functionCount>{})[static_cast<std::size_t>(fnc)] },
+              m_transform{ FunctionTransform::active(fnc) }, m_cache{ cache }
+        {
+        }
+
+        void operator()(std::span<FixedChromosome<T, D>* const> rows) const
+        {
+            thread_local std::vector<FixedChromosome<T, D>*> pending{};
+            thread_local std::vector<FitnessCache::Key> keys{};
+            std::span<FixedChromosome<T, D>* const> misses{ rows };
+
+            if(m_cache)
+            {
+                pending.clear();
+                keys.clear();
+
+                for(FixedChromosome<T, D>* row : rows)
+                {
+                    const FitnessCache::Key key{ FitnessCache::key(row->genes.data(), sizeof(row->genes)) };
+                    if(m_cache->lookup(key, row->fitness))
+                        continue;
+
+                    keys.push_back(key);
+                    pending.push_back(row);
+                }
+
+                misses = std::span<FixedChromosome<T, D>* const>(pending);
+            }
+
+            if(m_transform)
+            {
+                thread_local std::vector<const T*> genomes{};
+                thread_local std::vector<double> fitness{};
+                genomes.clear();
+                for(const FixedChromosome<T, D>* row : misses)
+                    genomes.push_back(row->genes.data());
+
+                fitness.resize(misses.size());
+                m_transform->evaluateBlock(std::span<const T* const>(genomes), std::span<double>(fitness));
+
+                for(std::size_t i {0}; i < misses.size(); ++i)
+                    misses[i]->fitness = fitness[i];
+            }
+            else
+                m_rows(misses.data(), misses.size());
+
+            if(m_cache)
+            {
+                for(std::size_t i {0}; i < misses.size(); ++i)
+                    m_cache->insert(keys[i], misses[i]->fitness);
+            }
+
+            countEvaluations(misses.size());
+        }
+
+    private:
+        RowEvaluator<T, D>       m_rows;
+        const FunctionTransform* m_transform;
+        FitnessCache*            m_cache;
+    };
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    /// @brief The search box in the gene type; clamping is an unrolled min/max, the other modes go through SearchBounds.
+    template <typename T, std::size_t D>
+    class FixedBounds
+    {
+    public:
+        explicit FixedBounds(const SearchBounds& bounds)
+            : m_bounds{ bounds }
+        {
+            for(std::size_t j {0}; j < D; ++j)
+            {
+                m_lower[j] = static_cast<T>(bounds.lower(j));
+                m_upper[j] = static_cast<T>(bounds.upper(j));
+            }
+        }
+
+        void repair(std::array<T, D>& genes) const
+        {
+            if(m_bounds.mode() != BoundaryHandling::clamp)
+            {
+                m_bounds.repair(genes.data(), D);
+                return;
+            }
+
+            for(std::size_t j {0}; j < D; ++j)
+                genes[j] = std::min(std::max(genes[j], m_lower[j]), m_upper[j]);
+        }
+
+    private:
+        const SearchBounds& m_bounds;
+        std::array<T, D>    m_lower{};
+        std::array<T, D>    m_upper{};
+    };
+
+    /// @brief Gaussian mutation with the same draws as BasicChromosome::mutate.
+    /// @return true if at least one gene was changed
+    template <typename T, std::size_t D>
+    bool mutateGenes(std::array<T, D>& genes, double rate, double strength)
+    {
+        // Gerador da thread resolvido uma vez: cada acesso a Random::mt passa pela inicialização do thread_local
+        std::mt19937& rng{ Random::mt };
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::normal_distribution<T> dist(0, static_cast<T>(strength));
+        bool changed{ false };
+
+        for(std::size_t j {0}; j < D; ++j)
+        {
+            if(unit(rng) < rate)
+            {
+                genes[j] += dist(rng);
+                changed = true;
+            }
+        }
+
+        return changed;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    /// @brief breedBlock operators over FixedChromosome<T, D> rows: unrolled crossover kernels, mutation and
+    /// clamping, and the evaluator with the benchmark picked once per run.
+    template <typename T, std::size_t D>
+    struct FixedOperators
+    {
+        const FixedPopulation<T, D>& parents;
+        const FixedBounds<T, D>&     box;
+        const FixedEvaluator<T, D>&  evaluator;
+        const CrossoverSettings&     settings;
+        Points                       points;
+        const RunState&              state;
+
+        void crossover(std::span<const MatingPair> pairs, FixedChromosome<T, D>* children, std::size_t count) const
+        {
+            const bool repairChildren{ points == Points::blx || points == Points::sbx };
+            FixedChromosome<T, D> spare{};
+
+            for(std::size_t k {0}; k < pairs.size() && 2 * k < count; ++k)
+            {
+                FixedChromosome<T, D>& first{ children[2 * k] };
+                FixedChromosome<T, D>& second{ 2 * k + 1 < count ? children[2 * k + 1] : spare };
+
+                crossoverPair<T, D>(parents[pairs[k].first].genes.data(), parents[pairs[k].second].genes.data(),
+                                    first.genes.data(), second.genes.data(), points, settings);
+
+                if(repairChildren)
+                {
+                    box.repair(first.genes);
+                    box.repair(second.genes);
+                }
+            }
+        }
+
+        bool mutate(FixedChromosome<T, D>& mutant, const FixedChromosome<T, D>& child) const
+        {
+            mutant.genes = child.genes;
+            const bool changed{ mutateGenes(mutant.genes, state.mutation_rate, state.mutation_strength) };
+            if(changed)
+                box.repair(mutant.genes);
+
+            return changed;
+        }
+
+        void evaluate(std::span<FixedChromosome<T, D>* const> rows) const
+        {
+            evaluator(rows);
+        }
+    };
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, std::size_t D>
+    Chromosome toChromosome(const FixedChromosome<T, D>& individual)
+    {
+        Chromosome chromosome{ std::vector<double>(individual.genes.begin(), individual.genes.end()) };
+        chromosome.set_fitness(individual.fitness);
+        return chromosome;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------------------
+
+    /// @brief geneticAlgorithm over FixedChromosome<T, D>: same operators, elitism and schedule, with the
+    /// population in two flat arrays and the children of each block bred and evaluated in place.
+    template <typename T, std::size_t D>
+    RunResult fixedGeneticAlgorithm(const Parameters& p, int numThreads, bool parallel)
+    {
+        std::unique_ptr<FitnessCache> cache{ p.fitness_cache_size > 0 ? std::make_unique<FitnessCache>(p.fitness_cache_size) : nullptr };
+
+        const SearchBounds bounds{ p.target_function, p.dimensions, p.boundary_handling };
+        const FixedBounds<T, D> box{ bounds };
+        const FixedEvaluator<T, D> evaluate{ p.target_function, cache.get() };
+        const int threads{ parallel ? std::max(1, numThreads) : 1 };
+
+        const std::size_t size{ static_cast<std::size_t>(p.pop_size) };
+        const std::size_t numElites{ static_cast<std::size_t>(std::min(p.pop_size, std::max(1, static_cast<int>(p.elite_fraction * p.pop_size)))) };
+        const std::size_t numBlocks{ (size - numElites + blockSize - 1) / blockSize };
+
+        // BLX e SBX corrigidos pelo FixedBounds depois do kernel, não pelo SearchBounds
+        CrossoverSettings crossoverSettings{ CrossoverSettings::from(p, bounds) };
+        crossoverSettings.bounds = nullptr;
+
+        RunState state{};
+        state.cache = cache.get();
+
+        ConvergenceTrace trace{ p.trace_length };
+        state.trace = trace.enabled() ? &trace : nullptr;
+        std::vector<PopulationMoments> moments(static_cast<std::size_t>(threads));
+
+        FixedPopulation<T, D> population(size);
+        FixedPopulation<T, D> nextGeneration(size);
+        std::vector<double> fitness(size);
+        ParentSelector select{};
+
+        const std::uint64_t seed{ Random::seed() };
+        const UnitCubeSampler sampler{ p.init_sampling, D, size, seed };
+        const std::size_t numChunks{ (size + initChunkSize - 1) / initChunkSize };
+
+        #pragma omp parallel for schedule(dynamic) num_threads(threads) if(numChunks > 1)
+        for(std::size_t chunk = 0; chunk < numChunks; ++chunk)
+        {
+            std::mt19937 rng{ Random::stream(seed, chunk) };
+            std::array<double, D> unit{};
+
+            const std::size_t end{ std::min(size, (chunk + 1) * initChunkSize) };
+            thread_local std::vector<FixedChromosome<T, D>*> rows{};
+            rows.clear();
+
+            for(std::size_t i {chunk * initChunkSize}; i < end; ++i)
+            {
+                sampler.point(i, unit.data(), rng);
+
+                for(std::size_t j {0}; j < D; ++j)
+                    population[i].genes[j] = static_cast<T>(bounds.lower(j) + unit[j] * (bounds.upper(j) - bounds.lower(j)));
+
+                rows.push_back(&population[i]);
+            }
+
+            evaluate(std::span<FixedChromosome<T, D>* const>(rows));
+        }
+
+        std::sort(population.begin(), population.end());
+
+        int generations{ p.nIterations };
+        StopReason stop{ StopReason::iterations };
+
+        for(int generation {0}; generation < p.nIterations; ++generation)
+        {
+            state.generation = generation;
+            updateMutationSchedule(p, state);
+
+            std::copy(population.begin(), population.begin() + static_cast<std::ptrdiff_t>(numElites), nextGeneration.begin());
+
+            {
+                const PhaseScope scope{ GaPhase::selection, 0 };   // indivíduos contados em breedBlock
+                for(std::size_t i {0}; i < size; ++i)
+                    fitness[i] = population[i].fitness;
+
+                select.prepare(std::span<const double>(fitness), p.method, tournamentSize(p));
+            }
+
+            if(state.trace)
+            {
+                for(PopulationMoments& partial : moments)
+                    partial.reset(D);
+                for(std::size_t i {0}; i < numElites; ++i)
+                    moments[0].add(std::span<const T>(population[i].genes), population[i].fitness);
+            }
+
+            const FixedOperators<T, D> operators{ population, box, evaluate, crossoverSettings, p.points, state };
+            int successes{ 0 };
+
+            #pragma omp parallel for schedule(dynamic) num_threads(threads) reduction(+:successes) if(threads > 1)
+            for(std::size_t block = 0; block < numBlocks; ++block)
+            {
+                const std::size_t first{ numElites + block * blockSize };
+                const std::size_t count{ std::min(blockSize, size - first) };
+                FixedChromosome<T, D>* children{ nextGeneration.data() + first };
+
+                thread_local std::vector<MatingPair> pairs{};
+                pairs.resize((count + 1) / 2);
+
+                successes += breedBlock(select, operators, std::span<MatingPair>(pairs), children, count);
+
+                if(state.trace)
+                {
+                    PopulationMoments& partial{ moments[static_cast<std::size_t>(omp_get_thread_num())] };
+                    for(std::size_t i {0}; i < count; ++i)
+                        partial.add(std::span<const T>(children[i].genes), children[i].fitness);
+                }
+            }
+
+            state.mutation_attempts = static_cast<int>(size - numElites);
+            state.mutation_successes = successes;
+
+            if(state.trace)
+            {
+                for(std::size_t t {1}; t < moments.size(); ++t)
+                    moments[0] += moments[t];
+                state.trace->record(moments[0].stats(generation, state.mutation_rate, state.mutation_strength));
+            }
+
+            population.swap(nextGeneration);
+
+            {
+                const PhaseScope scope{ GaPhase::sort, size };
+                std::sort(population.begin(), population.end());
+            }
+
+            // Imprimir a cada 100 gerações
+            if((generation + 1) % 100 == 0 || generation == p.nIterations - 1)
+                printSolution(toChromosome(population[BEST_SOLUTION]), generation);
+
+            if(p.stop_at_fitness && population[BEST_SOLUTION].fitness <= p.stop_fitness)
+            {
+                printSolution(toChromosome(population[BEST_SOLUTION]), generation);
+                generations = generation + 1;
+                stop = StopReason::stop_fitness;
+                break;
+            }
+        }
+
+        RunResult result{ toChromosome(population[BEST_SOLUTION]), cache ? cache->stats() : CacheStats{}, generations, stop };
+        result.trace = trace.chronological();
+
+        return result;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+bool fixedGenomeApplies(const Parameters& p)
+{
+    const std::size_t dimensions{ SearchBounds(p.target_function, p.dimensions, p.boundary_handling).size() };
+
+    return !p.large_population && p.pop_size > 1 && hasFixedChromosome(dimensions) &&
+           p.surrogate == SurrogateType::none && p.local_search == LocalSearch::none && p.niching == Niching::none;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+RunResult fixedGenomeGA(const Parameters& p, int numThreads, bool parallel)
+{
+    switch(SearchBounds(p.target_function, p.dimensions, p.boundary_handling).size())
+    {
+        case 2:  return fixedGeneticAlgorithm<T, 2>(p, numThreads, parallel);
+        case 3:  return fixedGeneticAlgorithm<T, 3>(p, numThreads, parallel);
+        case 4:  return fixedGeneticAlgorithm<T, 4>(p, numThreads, parallel);
+        case 5:  return fixedGeneticAlgorithm<T, 5>(p, numThreads, parallel);
+        case 6:  return fixedGeneticAlgorithm<T, 6>(p, numThreads, parallel);
+        case 8:  return fixedGeneticAlgorithm<T, 8>(p, numThreads, parallel);
+        case 10: return fixedGeneticAlgorithm<T, 10>(p, numThreads, parallel);
+        case 12: return fixedGeneticAlgorithm<T, 12>(p, numThreads, parallel);
+        case 16: return fixedGeneticAlgorithm<T, 16>(p, numThreads, parallel);
+        default: return geneticAlgorithm<T>(p, numThreads, parallel);
+    }
+}
+
+template RunResult fixedGenomeGA<float>(const Parameters&, int, bool);
+template RunResult fixedGenomeGA<double>(const Parameters&, int, bool);
@@ -0,0 +1,177 @@
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include "gao.h"
+#include "gao_c.h"
+#include "FileLoader.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+struct gao_optimizer
+{
+    gao::Optimizer optimizer;
+};
+
+namespace {
+
+    thread_local std::string lastError{};
+
+    /// @brief Runs `body`, turning a C++ exception into `onError` plus gao_last_error().
+    template <typename F, typename R>
+    R guarded(F&& body, R onError)
+    {
+        try
+        {
+            lastError.clear();
+            return body();
+        }
+        catch(const std::exception& e)
+        {
+            lastError = e.what();
+        }
+        catch(...)
+        {
+            lastError = "unknown error";
+        }
+
+        return onError;
+    }
+
+    /// @brief Value of a C enum field, checked against the `count` values of E.
+    template <typename E>
+    E toEnum(int value, int count, const char* field)
+    {
+        if(value < 0 || value >= count)
+            throw std::invalid_argument(std::string{ field } + " must be in [0, " + std::to_string(count - 1) + "], got " + std::to_string(value) + '.');
+
+        return static_cast<E>(value);
+    }
+
+    Parameters toParameters(const gao_config& c)
+    {
+        Parameters p{};
+        p.dimensions                = c.dimensions;
+        p.pop_size                  = c.pop_size;
+        p.nIterations               = c.generations;
+        p.initial_mutation_rate     = c.initial_mutation_rate;
+        p.final_mutation_rate       = c.final_mutation_rate;
+        p.initial_mutation_strength = c.initial_mutation_strength;
+        p.final_mutation_strength   = c.final_mutation_strength;
+        p.elite_fraction            = c.elite_fraction;
+        p.method                    = toEnum<SelectionMethod>(c.selection_method, 3, "selection_method");
+        p.tournament_size           = c.tournament_size;
+        p.points                    = toEnum<Points>(c.crossover, 6, "crossover");
+        p.blx_alpha                 = c.blx_alpha;
+        p.sbx_eta                   = c.sbx_eta;
+        p.schedule                  = toEnum<MutationSchedule>(c.schedule, 4, "schedule");
+        p.boundary_handling         = toEnum<BoundaryHandling>(c.boundary_handling, 4, "boundary_handling");
+        p.stop_at_fitness           = c.stop_at_fitness != 0;
+        p.stop_fitness              = c.stop_fitness;
+        p.seed                      = static_cast<std::uint64_t>(c.seed);
+
+        return p;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+extern "C" {
+
+void gao_config_defaults(gao_config* config)
+{
+    *config = gao_config{};
+    config->dimensions                = 2;
+    config->pop_size                  = 100;
+    config->generations               = 1000;
+    config->initial_mutation_rate     = 0.5;
+    config->final_mutation_rate       = 0.1;
+    config->initial_mutation_strength = 0.5;
+    config->final_mutation_strength   = 0.001;
+    config->elite_fraction            = 0.1;
+    config->tournament_size           = 3;
+    config->crossover                 = 2;     // uniform
+    config->blx_alpha                 = 0.5;
+    config->sbx_eta                   = 15.0;
+}
+
+gao_optimizer* gao_create(const gao_config* config, const double* lower, const double* upper)
+{
+    return guarded([&]
+    {
+        if(!config || !lower || !upper || config->dimensions < 1)
+            throw std::invalid_argument("gao_create needs a config and dimensions >= 1 lower/upper bounds.");
+
+        const std::size_t n{ static_cast<std::size_t>(config->dimensions) };
+        return new gao_optimizer{ gao::Optimizer{ toParameters(*config), std::vector<double>(lower, lower + n), std::vector<double>(upper, upper + n) } };
+    }, static_cast<gao_optimizer*>(nullptr));
+}
+
+gao_optimizer* gao_create_from_file(const char* path)
+{
+    return guarded([&]
+    {
+        if(!path)
+            throw std::invalid_argument("gao_create_from_file needs a path.");
+
+        return new gao_optimizer{ gao::Optimizer{ FileLoader::loadFromTXT(path) } };
+    }, static_cast<gao_optimizer*>(nullptr));
+}
+
+void gao_destroy(gao_optimizer* optimizer)
+{
+    delete optimizer;
+}
+
+size_t gao_dimensions(const gao_optimizer* optimizer)
+{
+    return optimizer->optimizer.dimensions();
+}
+
+const double* gao_ask(gao_optimizer* optimizer, size_t* count)
+{
+    return guarded([&]
+    {
+        const std::span<const double> batch{ optimizer->optimizer.ask() };
+        if(count)
+            *count = optimizer->optimizer.batchSize();
+        return batch.data();
+    }, static_cast<const double*>(nullptr));
+}
+
+int gao_tell(gao_optimizer* optimizer, const double* fitness, size_t count)
+{
+    return guarded([&]
+    {
+        optimizer->optimizer.tell(std::span<const double>(fitness, count));
+        return 0;
+    }, -1);
+}
+
+int gao_generation(const gao_optimizer* optimizer)
+{
+    return optimizer->optimizer.generation();
+}
+
+double gao_best_fitness(const gao_optimizer* optimizer)
+{
+    return optimizer->optimizer.bestFitness();
+}
+
+const double* gao_best_genes(const gao_optimizer* optimizer)
+{
+    return optimizer->optimizer.bestGenes().data();
+}
+
+int gao_done(const gao_optimizer* optimizer)
+{
+    return optimizer->optimizer.done() ? 1 : 0;
+}
+
+const char* gao_last_error(void)
+{
+    return lastError.c_str();
+}
+
+}
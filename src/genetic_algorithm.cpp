@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include "engines.h"
+#include "genetic_operators.h"
+#include "MutationSchedule.h"
+#include "SearchBounds.h"
+#include "island.h"
+#include "local_search.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+RunResult geneticAlgorithm(const Parameters& p, int numThreads, bool parallel, IslandLink* island)
+{
+   std::unique_ptr<FitnessCache> cache{ p.fitness_cache_size > 0 ? std::make_unique<FitnessCache>(p.fitness_cache_size) : nullptr };
+
+   const SearchBounds bounds{ p.target_function, p.dimensions, p.boundary_handling };
+   RunState state{};
+   state.cache = cache.get();
+
+   ConvergenceTrace trace{ p.trace_length };
+   state.trace = trace.enabled() ? &trace : nullptr;
+
+   Population<T> population{ initialization<T>(bounds, p.pop_size, p.init_sampling, parallel ? numThreads : 1) };
+   
+   evaluatePopulation(population, p.target_function, cache.get());
+
+   // Modelo substituto treinado desde a população inicial
+   std::unique_ptr<Surrogate> surrogate{ p.surrogate != SurrogateType::none ? std::make_unique<Surrogate>(p, bounds) : nullptr };
+   state.surrogate = surrogate.get();
+   if(surrogate)
+   {
+      for(const auto& individual : population)
+         surrogate->record(individual.genes(), individual.get_fitness());
+      surrogate->retrain();
+   }
+
+   std::sort(population.begin(), population.end());
+
+   // Segundo buffer reaproveitado entre gerações: os filhos são construídos direto nele
+   Population<T> nextGeneration(p.pop_size);
+
+   int generations{ p.nIterations };
+   const int localSearchInterval{ p.local_search_interval > 0 ? p.local_search_interval : 10 };
+   StopReason stop{ StopReason::iterations };
+
+   for(int generation {0}; generation < p.nIterations; ++generation)
+   {
+      state.generation = generation;
+      updateMutationSchedule(p, state);
+
+      if(parallel)
+         parallelCreateNewGeneration(population, nextGeneration, p, bounds, state, numThreads);
+      else
+         createNewGeneration(population, nextGeneration, p, bounds, state);
+
+      population.swap(nextGeneration);
+
+      if(surrogate)
+         surrogate->retrain();
+
+      // Modo memético: busca local nas elites a cada local_search_interval gerações
+      if(p.local_search != LocalSearch::none && (generation + 1) % localSearchInterval == 0)
+         refineElites(population, p, bounds, state, parallel ? numThreads : 1);
+        
+      // Imprimir a cada 100 gerações
+      if((generation + 1) % 100 == 0 || generation == p.nIterations - 1)
+         printSolution(Chromosome(population[BEST_SOLUTION]), generation);
+
+      // Alvo atingido numa execução isolada; nas ilhas quem decide é o coordenador, pelo melhor global
+      if(!island && p.stop_at_fitness && population[BEST_SOLUTION].get_fitness() <= p.stop_fitness)
+      {
+         printSolution(Chromosome(population[BEST_SOLUTION]), generation);
+         generations = generation + 1;
+         stop = StopReason::stop_fitness;
+         break;
+      }
+
+      // Migração; o coordenador pode encerrar todas as ilhas antes do fim
+      if(island && island->due(generation) && island->exchange(population, state))
+      {
+         printSolution(Chromosome(population[BEST_SOLUTION]), generation);
+         generations = generation + 1;
+         stop = StopReason::stop_fitness;
+         break;
+      }
+   }
+
+   RunResult result{ Chromosome(population[BEST_SOLUTION]), cache ? cache->stats() : CacheStats{}, generations, stop };
+   result.trace = trace.chronological();
+   if(surrogate)
+      result.surrogate = surrogate->stats();
+
+   return result;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void printSolution(const Chromosome& solution, int generation)
+{
+   std::cout << "Generation: " << generation + 1 << '\n';
+   std::cout << "\tGenes: ";
+   std::cout << solution << '\n';
+   std::cout << "\tFitness: " << solution.get_fitness() << '\n';
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template RunResult geneticAlgorithm<float>(const Parameters&, int, bool, IslandLink*);
+template RunResult geneticAlgorithm<double>(const Parameters&, int, bool, IslandLink*);
@@ -1,377 +1,614 @@
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <omp.h>
 #include "Utils.h"
+#include "breeding.h"
 #include "genetic_operators.h"
+#include "sampling.h"
+#include "crossover.h"
+#include "niching.h"
+#include "PerfCounters.h"
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
 // std::vector<int> selectRandomIndices(int populationSize, int numCandidates);
-std::vector<double> getFitnessArray(const std::vector<Chromosome>& pop);
+template <typename T>
+void fillFitnessArray(const Population<T>& pop, std::vector<double>& fitnessArray);
+template <typename T>
+void startMoments(const Population<T>& prev_gen, int numElites, std::size_t dimensions, PopulationMoments& moments);
+int eliteCount(const Parameters& p);
+int fusedBlockSize(std::size_t genomeBytes);
+template <typename T>
+int screenChildren(const Population<T>& prev_gen, Population<T>& next_gen, int begin, int end,
+                   const Parameters& p, const RunState& s, const SearchBounds& bounds, std::span<const MatingPair> pairs);
+template <typename T>
+void crowdingReplacement(const Population<T>& prev_gen, Population<T>& next_gen, int begin, int end, std::span<const MatingPair> pairs);
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-std::vector<Chromosome> initialization(TargetFunction target_fnc, int dimensions, int populationSize)
+namespace {
+
+    /// @brief breedBlock operators over BasicChromosome rows.
+    template <typename T>
+    struct VectorOperators
+    {
+        const Population<T>&     parents;
+        const CrossoverSettings& settings;
+        Points                   points;
+        const SearchBounds&      bounds;
+        const RunState&          state;
+        TargetFunction           target;
+        BasicChromosome<T>&      spare;
+
+        void crossover(std::span<const MatingPair> pairs, BasicChromosome<T>* children, std::size_t count) const
+        {
+            crossoverBatch(parents, pairs, children, count, points, settings, spare);
+        }
+
+        // Cópia mutada do filho, corrigida nos limites na mesma passada pelos genes
+        bool mutate(BasicChromosome<T>& mutant, const BasicChromosome<T>& child) const
+        {
+            return mutant.mutateFrom(child, state.mutation_rate, state.mutation_strength, bounds);
+        }
+
+        void evaluate(std::span<BasicChromosome<T>* const> rows) const
+        {
+            evaluateBatch(rows, target, state.cache);
+        }
+    };
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Builds the initial population in parallel chunks, writing genes straight into their slots.
+///
+/// Every chunk draws from its own RNG stream, so the result does not depend on which thread filled it.
+template <typename T>
+Population<T> initialization(const SearchBounds& bounds, int populationSize, InitSampling method, int numThreads)
 {
-    if(populationSize <= 0 || dimensions <= 0) 
+    if(populationSize <= 0 || bounds.size() == 0) 
         throw std::invalid_argument("Invalid parameters provided.");
    
-    std::vector<Chromosome> initial_population;
-    initial_population.reserve(populationSize);
+    constexpr int chunkSize{ 4096 };
 
-   using enum TargetFunction;
-   using enum BoundType;
-   using enum Points;
-   using enum SelectionMethod;
+    const std::size_t n{ bounds.size() };
+    const std::uint64_t seed{ Random::seed() };
+    const UnitCubeSampler sampler{ method, n, static_cast<std::uint64_t>(populationSize), seed };
+    const int numChunks{ (populationSize + chunkSize - 1) / chunkSize };
 
-   auto bounds{ getBound(target_fnc) };
+    Population<T> initial_population(populationSize);
 
-   if(target_fnc == mccormick)
-   {
-        auto bounds_pair{ std::get<BoundsPair>(bounds) }; // Lida com BoundPair
+    #pragma omp parallel for schedule(dynamic) num_threads(numThreads) if(numChunks > 1)
+    for(int chunk = 0; chunk < numChunks; ++chunk)
+    {
+        std::mt19937 rng{ Random::stream(seed, static_cast<std::uint64_t>(chunk)) };
+        std::vector<double> unit(n);
 
-        auto [x_lower, x_upper]{ std::get<static_cast<int>(lower)>(bounds_pair) };
-        auto [y_lower, y_upper]{ std::get<static_cast<int>(higher)>(bounds_pair) };
+        const int end{ std::min(populationSize, (chunk + 1) * chunkSize) };
 
-       
-        for(int i {0}; i < populationSize; ++i)
+        for(int i {chunk * chunkSize}; i < end; ++i)
         {
-            double x{ Random::get(x_lower, x_upper) };
-            double y{ Random::get(y_lower, y_upper) };
+            sampler.point(static_cast<std::uint64_t>(i), unit.data(), rng);
 
-            initial_population.emplace_back(std::vector<double>{ x, y });
-        }
-   }      
-   else
-   {
-        auto bounds_single = std::get<Bounds>(bounds); // Acessa o Bounds específico
-        auto [lower, upper] = bounds_single;
-
-        std::vector<double> genes(dimensions);
-        
-        for(int i {0}; i < populationSize; ++i)
-        {
-            for (auto& gene : genes) 
-                gene = Random::get(lower, upper);
-            
-            initial_population.emplace_back(genes);
+            std::vector<T>& genes{ initial_population[i].get_genes_array() };
+            genes.resize(n);
+
+            for(std::size_t j {0}; j < n; ++j)
+                genes[j] = static_cast<T>(bounds.lower(j) + unit[j] * (bounds.upper(j) - bounds.lower(j)));
         }
-   }
+    }
 
-   return initial_population;
+    return initial_population;
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-void evaluatePopulation(std::vector<Chromosome>& population, TargetFunction target_fnc)
+template <typename T>
+void evaluatePopulation(Population<T>& population, TargetFunction target_fnc, FitnessCache* cache)
 {
-    for(Chromosome& individual : population)
-        individual.evaluate_solution(target_fnc);
+    thread_local std::vector<BasicChromosome<T>*> individuals{};
+    individuals.clear();
+    for(BasicChromosome<T>& individual : population)
+        individuals.push_back(&individual);
+
+    evaluateBatch(std::span<BasicChromosome<T>* const>(individuals), target_fnc, cache);
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-const Chromosome& selection(const std::vector<Chromosome>& population, int populationSize, SelectionMethod method, int numCandidates)
+/// @brief Runs winners.size() tournaments over a contiguous fitness array.
+///
+/// All candidate indices are drawn in one pass (multiply-shift bounded draws, no per-call allocation),
+/// then every tournament is reduced over its slice; large tournaments use a vectorized min followed by
+/// a scan for the first candidate holding it.
+void tournamentSelection(std::span<const double> fitness, int tournamentSize, std::span<int> winners)
 {
-    if(method == SelectionMethod::tournament)
-    {
-        std::vector<int> selectedIndices(numCandidates);
-        for (int i = 0; i < numCandidates; ++i) 
-            selectedIndices[i] = Random::uniform(0, populationSize);
+    constexpr int simdThreshold{ 16 };
+
+    const std::size_t k{ static_cast<std::size_t>(std::max(1, tournamentSize)) };
+    const std::uint64_t populationSize{ fitness.size() };
 
-        // Encontra o índice do vencedor com base no menor fitness
-        int winnerIndex { selectedIndices[0] }; 
+    thread_local std::vector<int> candidates{};
+    candidates.resize(winners.size() * k);
 
-        for (int i = 1 ; i < numCandidates; ++i) 
+    for(int& candidate : candidates)
+        candidate = static_cast<int>((static_cast<std::uint64_t>(Random::mt()) * populationSize) >> 32);
+
+    // Primeiro candidato com o menor fitness; NaN perde para qualquer número
+    const auto firstBest{ [fitness, k](const int* slice) {
+        int winner{ slice[0] };
+        for(std::size_t j {1}; j < k; ++j)
         {
-            if(population[selectedIndices[i]].get_fitness() < population[winnerIndex].get_fitness()) 
-                winnerIndex = selectedIndices[i];
+            if(fitness[slice[j]] < fitness[winner] || std::isnan(fitness[winner]))
+                winner = slice[j];
         }
-        
-        return population[winnerIndex];
-    }
+        return winner;
+    } };
 
-    else if(method == SelectionMethod::fps)
+    for(std::size_t t {0}; t < winners.size(); ++t)
     {
-        std::vector<double> fitnessArray{ getFitnessArray(population) };
+        const int* slice{ candidates.data() + t * k };
 
-        double maxFitness{ *std::max_element(fitnessArray.begin(), fitnessArray.end()) };
-        std::transform(fitnessArray.begin(), fitnessArray.end(), fitnessArray.begin(),
-                [maxFitness](double f) { return maxFitness - f + 1e-6; });
+        if(k >= simdThreshold)
+        {
+            double best{ fitness[slice[0]] };
 
-        double totalFitness{ std::accumulate(fitnessArray.begin(), fitnessArray.end(), 0.0) };
+            #pragma omp simd reduction(min:best)
+            for(std::size_t j = 1; j < k; ++j)
+                best = std::min(best, fitness[slice[j]]);
 
-        std::vector<double> probabilities(populationSize);
+            std::size_t j{ 0 };
+            while(j < k && fitness[slice[j]] != best)
+                ++j;
 
-        std::transform(fitnessArray.begin(), fitnessArray.end(), probabilities.begin(),
-                [totalFitness](double f) { return f / totalFitness; });
-        
-        std::vector<double> roulette(populationSize);
-        std::partial_sum(probabilities.begin(), probabilities.end(), std::back_inserter(roulette));
+            // Mínimo NaN (nenhum candidato é igual a ele): refaz o torneio pelo caminho escalar
+            winners[t] = j < k ? slice[j] : firstBest(slice);
+        }
+        else
+            winners[t] = firstBest(slice);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void ParentSelector::prepare(std::span<const double> fitness, SelectionMethod method, int tournamentSize)
+{
+    const std::size_t n{ fitness.size() };
+    m_method = method;
+    m_tournamentSize = std::max(1, tournamentSize);
+    m_weights.resize(n);
 
-        double magicNum{ Random::rand() };
-        auto it{ std::lower_bound(roulette.begin(), roulette.end(), magicNum) };
-        return population[std::distance(roulette.begin(), it)];
+    if(method == SelectionMethod::tournament)
+    {
+        std::copy(fitness.begin(), fitness.end(), m_weights.begin());
+        return;
     }
 
-    else if(method == SelectionMethod::ranking) 
+    m_order.clear();
+
+    if(method == SelectionMethod::fps)
     {
+        // Indivíduos eliminados pelo clearing (fitness máximo) ficam fora da roleta
+        constexpr double cleared{ std::numeric_limits<double>::max() };
+        double maxFitness{ std::numeric_limits<double>::lowest() };
+        for(const double f : fitness)
+            if(f < cleared)
+                maxFitness = std::max(maxFitness, f);
+
+        for(std::size_t i {0}; i < n; ++i)
+            m_weights[i] = fitness[i] < cleared ? maxFitness - fitness[i] + 1e-6 : 0.0;
+    }
+    else
+    {
+        // O nicho muda a ordem da fitness de seleção: o ranking passa a ser pela ordem dela
+        if(!std::is_sorted(fitness.begin(), fitness.end()))
+        {
+            m_order.resize(n);
+            std::iota(m_order.begin(), m_order.end(), 0);
+            std::stable_sort(m_order.begin(), m_order.end(), [fitness](int a, int b) { return fitness[a] < fitness[b]; });
+        }
+
+        // Pesos lineares pelo ranking: sem o nicho a população está ordenada e o índice é a posição
         constexpr double min{ 0.8 };
         constexpr double max{ 1.1 };
+        const double last{ static_cast<double>(std::max<std::size_t>(1, n - 1)) };
 
-        // Calcular as probabilidades de seleção com base nos indices
-        std::vector<double> probabilities(populationSize);
-        for (int i {0}; i < populationSize; ++i)
-            probabilities[i] = max - (max - min) * (static_cast<double>(i) / (populationSize - 1));
-    
-        // Normalizar as probabilidades para garantir que a soma seja 1
-        double totalProbability{ std::accumulate(probabilities.begin(), probabilities.end(), 0.0) };
-        for(double& prob : probabilities) 
-            prob /= totalProbability;
-
-        // Criar uma distribuição acumulada dessas probabilidades
-        std::vector<double> cumulativeProb(populationSize);
-        std::partial_sum(probabilities.begin(), probabilities.end(), cumulativeProb.begin());
+        for(std::size_t i {0}; i < n; ++i)
+            m_weights[i] = max - (max - min) * (static_cast<double>(i) / last);
+    }
 
-        double magicNum{ Random::rand() };
-        auto it{ std::lower_bound(cumulativeProb.begin(), cumulativeProb.end(), magicNum) };
+    std::partial_sum(m_weights.begin(), m_weights.end(), m_weights.begin());
+    m_total = m_weights.back();
+}
 
-        if(it == cumulativeProb.end()) // Caso de arredondamento
-            return population.back();
+void ParentSelector::draw(std::span<int> winners) const
+{
+    if(m_method == SelectionMethod::tournament)
+    {
+        tournamentSelection(std::span<const double>(m_weights), m_tournamentSize, winners);
+        return;
+    }
 
-        return population[std::distance(cumulativeProb.begin(), it)];
+    const std::size_t last{ m_weights.size() - 1 };
+    for(int& winner : winners)
+    {
+        const double value{ Random::uniform(0.0, m_total) };
+        const auto it{ std::lower_bound(m_weights.begin(), m_weights.end(), value) };
+        const std::size_t position{ std::min(last, static_cast<std::size_t>(it - m_weights.begin())) };
+        winner = m_order.empty() ? static_cast<int>(position) : m_order[position];
     }
+}
 
-    return * std::min_element(population.begin(), population.end(),
-                [](const Chromosome& a, const Chromosome& b) { return a.get_fitness() < b.get_fitness(); });
+void ParentSelector::drawPairs(std::span<MatingPair> pairs) const
+{
+    thread_local std::vector<int> winners{};
+    winners.resize(2 * pairs.size());
+    draw(std::span<int>(winners));
+
+    for(std::size_t k {0}; k < pairs.size(); ++k)
+        pairs[k] = { winners[2 * k], winners[2 * k + 1] };
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-std::pair<Chromosome, Chromosome> crossover(const Chromosome& parent1, const Chromosome& parent2, Points nPoints)
+/// @brief Fills next_gen[begin, end) with offspring of prev_gen, building every child in its final slot.
+///
+/// Children are produced in pairs; an odd-sized range makes its last pair keep only the first child.
+/// Without a surrogate the range is bred in blocks of fusedBlockSize children, each taken through
+/// breedBlock (selection, crossover, mutation, repair and evaluation) before the next block starts.
+/// @return number of mutations that improved their child
+template <typename T>
+int breedRange(const Population<T>& prev_gen, Population<T>& next_gen, int begin, int end,
+               const Parameters& p, const RunState& s, const SearchBounds& bounds, const ParentSelector& select, PopulationMoments* moments)
 {
-    const std::vector<double>& firstParentGenes { parent1.get_genes_array() };
-    const std::vector<double>& secondParentGenes{ parent2.get_genes_array() };
-
-    int size{ static_cast<int>(parent1.size()) };
+    int successes{ 0 };
+    const std::size_t count{ static_cast<std::size_t>(std::max(0, end - begin)) };
 
-    std::vector<double> firstChildGenes (size);
-    std::vector<double> secondChildGenes(size);
-
-    auto firstParentBegin{ firstParentGenes.begin() }; 
-    auto firstParentEnd{ firstParentGenes.end() }; 
+    if(prev_gen[0].size() > 1)
+    {
+        thread_local BasicChromosome<T> spare{};
+        thread_local std::vector<MatingPair> pairs{};
 
-    auto secondParentBegin{ secondParentGenes.begin() }; 
-    auto secondParentEnd{ secondParentGenes.end() }; 
+        const CrossoverSettings settings{ CrossoverSettings::from(p, bounds) };
+        const VectorOperators<T> operators{ prev_gen, settings, p.points, bounds, s, p.target_function, spare };
 
-    auto firstChildIt{ firstChildGenes.begin() }; 
-    auto secondChildIt{ secondChildGenes.begin() };
+        pairs.resize((count + 1) / 2);
 
-    if(nPoints == Points::one || size == 2)
-    {
-        int point{ Random::uniform(1, size) };
+        if(s.surrogate)
+        {
+            // Todos os pais da fatia sorteados antes; os filhos saem de uma vez do kernel de crossover
+            {
+                const PhaseScope scope{ GaPhase::selection, count };
+                select.drawPairs(std::span<MatingPair>(pairs));
+            }
+            {
+                const PhaseScope scope{ GaPhase::crossover, count };
+                operators.crossover(std::span<const MatingPair>(pairs), next_gen.data() + begin, count);
+            }
 
-        std::copy(firstParentBegin, firstParentBegin + point, firstChildIt);
-        std::copy(secondParentBegin + point, secondParentEnd, firstChildIt + point);
+            successes += screenChildren(prev_gen, next_gen, begin, end, p, s, bounds, std::span<const MatingPair>(pairs));
 
-        std::copy(secondParentBegin, secondParentBegin + point, secondChildIt);
-        std::copy(firstParentBegin + point, firstParentEnd, secondChildIt + point);
-    }
+            // Vagas descartadas pela previsão guardam um indivíduo já avaliado e competem como os demais filhos
+            if(p.niching == Niching::crowding)
+                crowdingReplacement(prev_gen, next_gen, begin, end, std::span<const MatingPair>(pairs));
 
-    else if(nPoints == Points::two)
-    {
-        std::pair<int, int> points{ Random::uniform(1, size), Random::uniform(1, size) };
+            if(moments)
+                for(int idx {begin}; idx < end; ++idx)
+                    moments->add(next_gen[idx].genes(), next_gen[idx].get_fitness());
+        }
+        else
+        {
+            // Pipeline fundido: cada bloco de filhos passa por todas as etapas enquanto os genes ainda estão no L2
+            const int block{ fusedBlockSize(prev_gen[0].size() * sizeof(T)) };
 
-        // Garante que os pontos são únicos e ordenados
-        while(points.first == points.second) 
-            points.second = Random::uniform(1, size);
-        
-        if (points.first > points.second)
-            std::swap(points.first, points.second);
+            for(int first {begin}; first < end; first += block)
+            {
+                const int last{ std::min(end, first + block) };
+                const std::size_t size{ static_cast<std::size_t>(last - first) };
+                const std::size_t firstPair{ static_cast<std::size_t>(first - begin) / 2 };
+                const std::span<MatingPair> blockPairs(pairs.data() + firstPair, (size + 1) / 2);
 
-        int point1{ points.first };
-        int point2{ points.second };
+                successes += breedBlock(select, operators, blockPairs, next_gen.data() + first, size);
 
-        std::copy(firstParentBegin, firstParentBegin + point1, firstChildIt);
-        std::copy(secondParentBegin + point1, secondParentBegin + point2, firstChildIt + point1);
-        std::copy(firstParentBegin + point2, firstParentEnd, firstChildIt + point2);
+                if(p.niching == Niching::crowding)
+                    crowdingReplacement(prev_gen, next_gen, first, last, std::span<const MatingPair>(blockPairs));
 
-        std::copy(secondParentBegin, secondParentBegin + point1, secondChildIt);
-        std::copy(firstParentBegin + point1, firstParentBegin + point2, secondChildIt + point1);
-        std::copy(secondParentBegin + point2, secondParentEnd, secondChildIt + point2);
+                if(moments)
+                    for(int idx {first}; idx < last; ++idx)
+                        moments->add(next_gen[idx].genes(), next_gen[idx].get_fitness());
+            }
+        }
     }
-    
-    else if(nPoints == Points::uniform)
+    else
     {
-        std::vector<int> mask(size);
-
-        for(int i {0}; i < size; ++i)
-            mask[i] = Random::get(0, 1);
+        thread_local std::vector<int> winners{};
+        {
+            const PhaseScope scope{ GaPhase::selection, count };
+            winners.resize(count);
+            select.draw(std::span<int>(winners));
+        }
 
-        for(int i {0}; i < size; i++)
+        for(int idx {begin}; idx < end; ++idx)
         {
-            if(mask[i] == 0)
+            const BasicChromosome<T>& parent{ prev_gen[winners[idx - begin]] };
+            BasicChromosome<T>& child{ next_gen[idx] };
+            child = parent;
+
+            if(child.mutate(s.mutation_rate, s.mutation_strength))
             {
-                firstChildGenes[i] = firstParentGenes[i];
-                secondChildGenes[i] = secondParentGenes[i];
+                child.checkBounds(bounds);
+
+                child.evaluate_solution(p.target_function, s.cache);
             }
+
+            if(child.get_fitness() < parent.get_fitness()) 
+                ++successes;
             else
-            {
-                firstChildGenes[i] = secondParentGenes[i];
-                secondChildGenes[i] = firstParentGenes[i];
-            }
-        }    
+                child = parent;
+
+            if(moments)
+                moments->add(child.genes(), child.get_fitness());
+        }
     }
 
-    return { Chromosome(firstChildGenes), Chromosome(secondChildGenes) };
+    return successes;
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-void mutation(Chromosome& child1, Chromosome& child2, const Parameters& p)
+/// @brief Surrogate path of breedRange: every child is mutated once, then only the best predicted fraction
+/// is evaluated; the other slots keep the individual they held in the previous generation.
+///
+/// Until the surrogate has a model every child is evaluated. Real evaluations feed the surrogate archive.
+/// @return number of evaluated children that beat their better parent
+template <typename T>
+int screenChildren(const Population<T>& prev_gen, Population<T>& next_gen, int begin, int end,
+                   const Parameters& p, const RunState& s, const SearchBounds& bounds, std::span<const MatingPair> pairs)
 {
-    Chromosome copy1{ child1 };
-    Chromosome copy2{ child2 };
+    const std::size_t count{ static_cast<std::size_t>(std::max(0, end - begin)) };
+    const std::shared_ptr<const SurrogateModel> model{ s.surrogate->model() };
 
-    copy1.mutate(p.mutation_rate, p.mutation_strength);
-    copy2.mutate(p.mutation_rate, p.mutation_strength);
+    thread_local std::vector<double> predicted{};
+    thread_local std::vector<std::size_t> order{};
 
-    copy1.checkBounds(p.target_function);
-    copy2.checkBounds(p.target_function);
+    // Sem a avaliação intermediária: a mutação vai direto no filho
+    {
+        const PhaseScope scope{ GaPhase::mutation, count };
+        for(int idx {begin}; idx < end; ++idx)
+            if(next_gen[idx].mutate(s.mutation_rate, s.mutation_strength))
+                next_gen[idx].checkBounds(bounds);
+    }
+
+    order.resize(count);
+    std::iota(order.begin(), order.end(), std::size_t{ 0 });
 
-    copy1.evaluate_solution(p.target_function);
-    copy2.evaluate_solution(p.target_function);
+    std::size_t evaluated{ count };
+    if(model && count > 0)
+    {
+        predicted.resize(count);
+        for(std::size_t i {0}; i < count; ++i)
+            predicted[i] = model->predict(next_gen[begin + static_cast<int>(i)].genes());
+
+        evaluated = std::clamp<std::size_t>(static_cast<std::size_t>(std::ceil(s.surrogate->fraction() * static_cast<double>(count))), 1, count);
+        std::nth_element(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(evaluated - 1), order.end(),
+                         [](std::size_t a, std::size_t b) { return predicted[a] < predicted[b]; });
+    }
 
-    if(copy1.get_fitness() < child1.get_fitness())
-        child1 = std::move(copy1);
+    int successes{ 0 };
+    const PhaseScope scope{ GaPhase::evaluation, evaluated };
+    for(std::size_t k {0}; k < count; ++k)
+    {
+        const int idx{ begin + static_cast<int>(order[k]) };
+        BasicChromosome<T>& child{ next_gen[idx] };
+
+        // Descartado pela previsão: o sobrevivente da geração anterior continua na vaga, sem duplicar pais
+        if(k >= evaluated)
+        {
+            child = prev_gen[idx];
+            continue;
+        }
 
-    if(copy2.get_fitness() < child2.get_fitness())
-        child2 = std::move(copy2);
+        child.evaluate_solution(p.target_function, s.cache);
+        s.surrogate->record(child.genes(), child.get_fitness());
+
+        const MatingPair& pair{ pairs[order[k] / 2] };
+        if(child.get_fitness() < std::min(prev_gen[pair.first].get_fitness(), prev_gen[pair.second].get_fitness()))
+            ++successes;
+    }
+
+    s.surrogate->count(evaluated, count - evaluated);
+
+    return successes;
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-/*void mutation(Chromosome& child, const Parameters& p)
+/// @brief Deterministic crowding: each child is matched with its closer parent and keeps its slot only if it is better.
+template <typename T>
+void crowdingReplacement(const Population<T>& prev_gen, Population<T>& next_gen, int begin, int end, std::span<const MatingPair> pairs)
 {
-    Chromosome copy{ child };
-    copy.mutate(p.mutation_rate, p.mutation_strength);
-    copy.checkBounds(p.target_function);
-    copy.evaluate_solution(p.target_function);
-    if(copy.get_fitness() < child.get_fitness())
-        child = std::move(copy);
-}*/
+    const auto distance{ [](std::span<const T> a, std::span<const T> b) {
+        double sum{ 0.0 };
+        for(std::size_t j {0}; j < a.size(); ++j)
+        {
+            const double diff{ static_cast<double>(a[j]) - static_cast<double>(b[j]) };
+            sum += diff * diff;
+        }
+        return sum;
+    } };
+
+    for(std::size_t k {0}; k < pairs.size(); ++k)
+    {
+        const int first{ begin + static_cast<int>(2 * k) };
+        const int second{ first + 1 };
+        const BasicChromosome<T>* parentA{ &prev_gen[pairs[k].first] };
+        const BasicChromosome<T>* parentB{ &prev_gen[pairs[k].second] };
+
+        // Casamento que minimiza a soma das distâncias filho-pai; par incompleto fica com o pai mais próximo
+        const double straight{ distance(next_gen[first].genes(), parentA->genes()) + (second < end ? distance(next_gen[second].genes(), parentB->genes()) : 0.0) };
+        const double crossed { distance(next_gen[first].genes(), parentB->genes()) + (second < end ? distance(next_gen[second].genes(), parentA->genes()) : 0.0) };
+        if(crossed < straight)
+            std::swap(parentA, parentB);
+
+        if(parentA->get_fitness() < next_gen[first].get_fitness())
+            next_gen[first] = *parentA;
+        if(second < end && parentB->get_fitness() < next_gen[second].get_fitness())
+            next_gen[second] = *parentB;
+    }
+}
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-std::vector<Chromosome> createNewGeneration(const std::vector<Chromosome>& prev_gen, const Parameters& p)
+int eliteCount(const Parameters& p)
 {
-    int numElites{ std::max(1, static_cast<int>(p.elite_fraction * p.pop_size)) };
+    return std::min(p.pop_size, std::max(1, static_cast<int>(p.elite_fraction * p.pop_size)));
+}
 
-    std::vector<Chromosome> newGeneration;
-    newGeneration.reserve(p.pop_size);
+/// @brief Candidates per tournament, with the default every engine shares when the key is absent or invalid.
+int tournamentSize(const Parameters& p)
+{
+    return p.tournament_size > 0 ? p.tournament_size : 3;
+}
 
-    for(int i {0}; i < numElites; ++i) 
-        newGeneration.push_back(prev_gen[i]);
+/// @brief Children per block of breedRange's fused pipeline, always even and in [2, 256].
+///
+/// A block's children, their mutated copies and the parents it reads (about three genomes per child) are
+/// sized to fit in 256 KiB of L2, so no pass over the block has to go back to memory.
+int fusedBlockSize(std::size_t genomeBytes)
+{
+    constexpr std::size_t l2Budget{ 256 * 1024 };
 
-    if(prev_gen[0].size() > 1)
-    {
-        while(std::ssize(newGeneration) < p.pop_size)
-        {
-            const Chromosome& firstParent { selection(prev_gen, p.pop_size, p.method) };
-            const Chromosome& secondParent{ selection(prev_gen, p.pop_size, p.method) };
+    const std::size_t children{ l2Budget / std::max<std::size_t>(1, 3 * genomeBytes) };
+    return static_cast<int>(std::clamp<std::size_t>(children, 2, 256)) & ~1;
+}
 
-            auto [firstChild, secondChild]{ crossover(firstParent, secondParent, p.points) };
+// -------------------------------------------------------------------------------------------------------------------------------------
 
-            firstChild.evaluate_solution(p.target_function);
-            secondChild.evaluate_solution(p.target_function);
+template <typename T>
+void createNewGeneration(const Population<T>& prev_gen, Population<T>& next_gen, const Parameters& p, const SearchBounds& bounds, RunState& s)
+{
+    const int numElites{ eliteCount(p) };
 
-            mutation(firstChild, secondChild, p);
+    next_gen.resize(p.pop_size);
 
-            newGeneration.push_back(firstChild);
-            newGeneration.push_back(secondChild);
-        }
-    } 
-    else
+    std::copy(prev_gen.begin(), prev_gen.begin() + numElites, next_gen.begin());
+
+    thread_local std::vector<double> fitness{};
+    thread_local ParentSelector select{};
     {
-        while(std::ssize(newGeneration) < p.pop_size)
-        {
-            const Chromosome& parent{ selection(prev_gen, p.pop_size, p.method) };
-            Chromosome child{ parent };
+        const PhaseScope scope{ GaPhase::selection, 0 };   // indivíduos contados em breedRange
+        fillFitnessArray(prev_gen, fitness);
 
-            child.mutate(p.mutation_rate, p.mutation_strength);
+        if(p.niching == Niching::sharing || p.niching == Niching::clearing)
+            applyNiching(prev_gen, p, bounds, fitness, 1);
 
-            child.checkBounds(p.target_function);
+        select.prepare(std::span<const double>(fitness), p.method, tournamentSize(p));
+    }
 
-            child.evaluate_solution(p.target_function);
+    // Estatísticas da geração acumuladas junto com a avaliação dos filhos
+    thread_local PopulationMoments moments{};
+    if(s.trace)
+        startMoments(prev_gen, numElites, bounds.size(), moments);
 
-            if(child.get_fitness() < parent.get_fitness()) 
-                newGeneration.push_back(child);
-            else 
-                newGeneration.push_back(parent);
-        }
-    }   
+    s.mutation_attempts = p.pop_size - numElites;
+    s.mutation_successes = breedRange(prev_gen, next_gen, numElites, p.pop_size, p, s, bounds, select, s.trace ? &moments : nullptr);
 
-    std::sort(newGeneration.begin(), newGeneration.end());
+    if(s.trace)
+        s.trace->record(moments.stats(s.generation, s.mutation_rate, s.mutation_strength));
 
-    return newGeneration;
+    const PhaseScope scope{ GaPhase::sort, next_gen.size() };
+    std::sort(next_gen.begin(), next_gen.end());
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-std::vector<Chromosome> parallelCreateNewGeneration(const std::vector<Chromosome>& prev_gen, const Parameters& p, int numThreads)
+/// @brief Start of slice `tid` of `numThreads` over [begin, end).
+///
+/// Boundaries are proportional, so slice sizes differ by at most one individual.
+int threadSliceStart(int begin, int end, int tid, int numThreads)
 {
-    int numElites{ std::max(1, static_cast<int>(p.elite_fraction * p.pop_size)) };
+    if(tid <= 0)
+        return begin;
+    if(tid >= numThreads)
+        return end;
 
-    (numElites & 1) ? numElites &= ~1 : numElites;
-    
-    int numNew{ p.pop_size - numElites };
+    const long long span{ end - begin };
+    return begin + static_cast<int>(span * tid / numThreads);
+}
 
-    std::vector<Chromosome> newGeneration;
-    newGeneration.reserve(p.pop_size);
+// -------------------------------------------------------------------------------------------------------------------------------------
 
-    for(int i {0}; i < numElites; ++i) 
-        newGeneration.push_back(prev_gen[i]);
+template <typename T>
+void parallelCreateNewGeneration(const Population<T>& prev_gen, Population<T>& next_gen, const Parameters& p, const SearchBounds& bounds, RunState& s, int numThreads)
+{
+    const int numElites{ eliteCount(p) };
+    int successes{ 0 };
 
-    std::vector<Chromosome> offspring(numNew);
+    next_gen.resize(p.pop_size);
 
-    if(prev_gen[0].size() > 1)
-    {
-        #pragma omp parallel for schedule(static) num_threads(numThreads)
-        for(int i = 0; i < numNew / 2; ++i)
-        {
-            const Chromosome& firstParent  { selection(prev_gen, p.pop_size, p.method) };
-            const Chromosome& secondParent { selection(prev_gen, p.pop_size, p.method) };
+    std::copy(prev_gen.begin(), prev_gen.begin() + numElites, next_gen.begin());
 
-            auto [firstChild, secondChild]{ crossover(firstParent, secondParent, p.points) };
+    thread_local std::vector<double> fitness{};
+    thread_local ParentSelector select{};
+    {
+        const PhaseScope scope{ GaPhase::selection, 0 };   // indivíduos contados em breedRange
+        fillFitnessArray(prev_gen, fitness);
 
-            mutation(firstChild, secondChild, p);
+        if(p.niching == Niching::sharing || p.niching == Niching::clearing)
+            applyNiching(prev_gen, p, bounds, fitness, numThreads);
 
-            int idx{ i * 2 };
-            offspring[idx] = firstChild;
-            offspring[idx + 1] = secondChild;
-        }
+        select.prepare(std::span<const double>(fitness), p.method, tournamentSize(p));
     }
-    else
+
+    // Uma soma parcial por thread; as elites entram na da thread 0
+    thread_local std::vector<PopulationMoments> moments{};
+    if(s.trace)
     {
-        #pragma omp parallel for schedule(static) num_threads(numThreads)
-        for(int i = 0; i < numNew; ++i)
-        {
-            const Chromosome& parent{ selection(prev_gen, p.pop_size, p.method) };
-            Chromosome child{ parent };
+        moments.resize(static_cast<std::size_t>(numThreads));
+        startMoments(prev_gen, numElites, bounds.size(), moments[0]);
+        for(std::size_t t {1}; t < moments.size(); ++t)
+            moments[t].reset(bounds.size());
+    }
 
-            child.mutate(p.mutation_rate, p.mutation_strength);
+    // Workers only read `s` and the selector; success counts are reduced and stored once the region is over
+    const RunState& state{ s };
+    const ParentSelector& selector{ select };
+    PopulationMoments* const partial{ s.trace ? moments.data() : nullptr };
 
-            child.checkBounds(p.target_function);
+    // Uma fatia por thread, ou pedaços de parallel_chunk indivíduos distribuídos dinamicamente
+    const int range{ p.pop_size - numElites };
+    const int pieces{ p.parallel_chunk > 0 ? std::max(numThreads, (range + p.parallel_chunk - 1) / p.parallel_chunk) : numThreads };
 
-            child.evaluate_solution(p.target_function);
+    #pragma omp parallel num_threads(numThreads) reduction(+:successes)
+    {
+        const int tid{ omp_get_thread_num() };
 
-            offspring[i] = (child.get_fitness() < parent.get_fitness()) ? child : parent;
+        #pragma omp for schedule(dynamic)
+        for(int piece = 0; piece < pieces; ++piece)
+        {
+            const int begin{ threadSliceStart(numElites, p.pop_size, piece, pieces) };
+            const int end  { threadSliceStart(numElites, p.pop_size, piece + 1, pieces) };
+
+            successes += breedRange(prev_gen, next_gen, begin, end, p, state, bounds, selector, partial ? partial + tid : nullptr);
         }
     }
 
-    std::move(offspring.begin(), offspring.end(), std::back_inserter(newGeneration));
-    std::sort(newGeneration.begin(), newGeneration.end());
+    s.mutation_attempts = p.pop_size - numElites;
+    s.mutation_successes = successes;
+
+    if(s.trace)
+    {
+        for(std::size_t t {1}; t < moments.size(); ++t)
+            moments[0] += moments[t];
+        s.trace->record(moments[0].stats(s.generation, s.mutation_rate, s.mutation_strength));
+    }
 
-    return newGeneration;
+    const PhaseScope scope{ GaPhase::sort, next_gen.size() };
+    std::sort(next_gen.begin(), next_gen.end());
 }
 
 // -----------------------------------------------------------------------------------------------------------------------------------------------
@@ -387,12 +624,35 @@ std::vector<Chromosome> parallelCreateNewGeneration(const std::vector<Chromosome
 //     return std::vector<int>(indices.begin(), indices.begin() + numCandidates);
 // }
 
-std::vector<double> getFitnessArray(const std::vector<Chromosome>& pop)
+/// @brief Resets `moments` and adds the elites, which are copied rather than evaluated.
+template <typename T>
+void startMoments(const Population<T>& prev_gen, int numElites, std::size_t dimensions, PopulationMoments& moments)
 {
-    std::vector<double> fitnessArray(pop.size());
+    moments.reset(dimensions);
+
+    for(int i {0}; i < numElites; ++i)
+        moments.add(prev_gen[i].genes(), prev_gen[i].get_fitness());
+}
+
+/// @brief Fitness of every individual, in population order, written into the caller's storage.
+template <typename T>
+void fillFitnessArray(const Population<T>& pop, std::vector<double>& fitnessArray)
+{
+    fitnessArray.resize(pop.size());
 
     for(std::size_t i {0}; i < pop.size(); ++i)
         fitnessArray[i] = pop[i].get_fitness();
-
-    return fitnessArray;
 }
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+// Instanciações explícitas para genes em float e double
+#define INSTANTIATE_GENETIC_OPERATORS(T) \
+    template Population<T> initialization<T>(const SearchBounds&, int, InitSampling, int); \
+    template void evaluatePopulation<T>(Population<T>&, TargetFunction, FitnessCache*); \
+    template int breedRange<T>(const Population<T>&, Population<T>&, int, int, const Parameters&, const RunState&, const SearchBounds&, const ParentSelector&, PopulationMoments*); \
+    template void createNewGeneration<T>(const Population<T>&, Population<T>&, const Parameters&, const SearchBounds&, RunState&); \
+    template void parallelCreateNewGeneration<T>(const Population<T>&, Population<T>&, const Parameters&, const SearchBounds&, RunState&, int);
+
+INSTANTIATE_GENETIC_OPERATORS(float)
+INSTANTIATE_GENETIC_OPERATORS(double)
@@ -1,15 +1,25 @@
 #pragma once
 
 #include <iostream>
+#include <span>
 #include <vector>
 #include "Chromosome.h"
 #include "Parameters.h"
+#include "RunState.h"
 
-std::vector<Chromosome> initialization(TargetFunction target_fnc, int dimensions, int populationSize);
-void evaluatePopulation(std::vector<Chromosome>& population, TargetFunction target_fnc);
-const Chromosome& selection(const std::vector<Chromosome>& population, int populationSize, SelectionMethod method, int numCandidates = 3);
-std::pair<Chromosome, Chromosome> crossover(const Chromosome& parent1, const Chromosome& parent2, Points nPoints);
-void mutation(Chromosome& child1, Chromosome& child2, const Parameters& p);
-// void mutation(Chromosome& child, const Parameters& p);
-std::vector<Chromosome> createNewGeneration(const std::vector<Chromosome>& prev_gen, const Parameters& p);
-std::vector<Chromosome> parallelCreateNewGeneration(const std::vector<Chromosome>& prev_gen, const Parameters& p, int numThreads);
+class ParentSelector;
+
+template <typename T = double>
+Population<T> initialization(const SearchBounds& bounds, int populationSize, InitSampling method = InitSampling::uniform, int numThreads = 1);
+template <typename T>
+void evaluatePopulation(Population<T>& population, TargetFunction target_fnc, FitnessCache* cache = nullptr);
+void tournamentSelection(std::span<const double> fitness, int tournamentSize, std::span<int> winners);
+int tournamentSize(const Parameters& p);
+template <typename T>
+int breedRange(const Population<T>& prev_gen, Population<T>& next_gen, int begin, int end, const Parameters& p, const RunState& s, const SearchBounds& bounds,
+               const ParentSelector& select, PopulationMoments* moments = nullptr);
+int threadSliceStart(int begin, int end, int tid, int numThreads);
+template <typename T>
+void createNewGeneration(const Population<T>& prev_gen, Population<T>& next_gen, const Parameters& p, const SearchBounds& bounds, RunState& s);
+template <typename T>
+void parallelCreateNewGeneration(const Population<T>& prev_gen, Population<T>& next_gen, const Parameters& p, const SearchBounds& bounds, RunState& s, int numThreads);
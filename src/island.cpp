@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include "island.h"
+#include "migration.h"
+#include "SearchBounds.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+IslandLink::IslandLink(Transport& transport, const Parameters& p)
+    : m_transport{ transport }, m_params{ p },
+      m_dimensions{ SearchBounds(p.target_function, p.dimensions, p.boundary_handling).size() },
+      m_interval{ p.migration_interval > 0 ? p.migration_interval : 50 },
+      m_migrants{ p.migration_size > 0 ? p.migration_size : 2 },
+      m_finished(static_cast<std::size_t>(transport.size()), false)
+{
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+std::size_t IslandLink::payloadLimit(const Parameters& p)
+{
+    const std::size_t dimensions{ SearchBounds(p.target_function, p.dimensions, p.boundary_handling).size() };
+    const std::size_t migrants{ static_cast<std::size_t>(p.migration_size > 0 ? p.migration_size : 2) };
+
+    return migrantPayloadLimit(migrants, dimensions);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+bool IslandLink::due(int generation) const
+{
+    return (generation + 1) % m_interval == 0;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+bool IslandLink::exchange(Population<T>& population, const RunState& s)
+{
+    const int size{ m_transport.size() };
+    const int rank{ m_transport.rank() };
+
+    if(size > 1)
+        m_transport.send((rank + 1) % size, MessageType::migrants, serializeMigrants(population, static_cast<std::size_t>(m_migrants)));
+
+    m_transport.send(0, MessageType::best, serializeMigrants(population, 1));
+
+    while(auto message{ m_transport.poll() })
+        handle(*message, &population, &s);
+
+    std::sort(population.begin(), population.end());
+
+    return m_stop;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void IslandLink::handle(Message& message, Population<T>* population, const RunState* s)
+{
+    try
+    {
+        switch(message.type)
+        {
+            case MessageType::migrants:
+            {
+                if(!population)
+                    break;
+
+                // Imigrantes são reavaliados localmente e substituem os piores
+                Population<T> migrants{ deserializeMigrants<T>(message.payload, m_dimensions) };
+                const std::size_t count{ std::min(migrants.size(), population->size() / 2) };
+
+                for(std::size_t k {0}; k < count; ++k)
+                {
+                    migrants[k].evaluate_solution(m_params.target_function, s ? s->cache : nullptr);
+                    (*population)[population->size() - 1 - k] = std::move(migrants[k]);
+                }
+                break;
+            }
+
+            case MessageType::best:
+            case MessageType::done:
+            {
+                if(message.type == MessageType::done && message.source >= 0 && message.source < m_transport.size())
+                    m_finished[static_cast<std::size_t>(message.source)] = true;
+
+                // Um "done" sem conteúdo vem de uma ilha que caiu
+                if(!message.payload.empty())
+                {
+                    Chromosome candidate{};
+                    if(Population<double> records{ deserializeMigrants<double>(message.payload, m_dimensions) }; !records.empty())
+                    {
+                        candidate = std::move(records[0]);
+                        candidate.evaluate_solution(m_params.target_function);
+                        offerGlobalBest(std::move(candidate));
+                    }
+                }
+                break;
+            }
+
+            case MessageType::stop:
+                m_stop = true;
+                break;
+        }
+    }
+    catch(const std::invalid_argument& e)
+    {
+        std::cerr << "Dropped message from island " << message.source << ": " << e.what() << std::endl;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void IslandLink::offerGlobalBest(Chromosome candidate)
+{
+    if(!m_hasGlobalBest || candidate < m_globalBest)
+    {
+        m_globalBest = std::move(candidate);
+        m_hasGlobalBest = true;
+    }
+
+    if(m_params.stop_at_fitness && !m_stopSent && m_globalBest.get_fitness() <= m_params.stop_fitness)
+    {
+        for(int r {0}; r < m_transport.size(); ++r)
+            m_transport.send(r, MessageType::stop, {});
+        m_stopSent = true;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+Chromosome IslandLink::finish(const Chromosome& best)
+{
+    m_transport.send(0, MessageType::done, serializeMigrants(Population<double>{ best }, 1));
+
+    if(m_transport.rank() != 0)
+        return best;
+
+    constexpr std::chrono::milliseconds pollInterval{ 10 };
+
+    // Coordenador: espera todas as ilhas terminarem, ainda repassando melhores e pedidos de parada
+    while(!std::all_of(m_finished.begin(), m_finished.end(), [](bool finished) { return finished; }))
+    {
+        if(auto message{ m_transport.poll() })
+            handle<double>(*message, nullptr, nullptr);
+        else
+            std::this_thread::sleep_for(pollInterval);
+    }
+
+    return m_hasGlobalBest ? m_globalBest : best;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template bool IslandLink::exchange<float>(Population<float>&, const RunState&);
+template bool IslandLink::exchange<double>(Population<double>&, const RunState&);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "Chromosome.h"
+#include "Parameters.h"
+#include "RunState.h"
+#include "Transport.h"
+
+/// @brief One island's side of the distributed island model.
+///
+/// Every `migration_interval` generations the island sends its best `migration_size` individuals to the
+/// next rank of the ring, reports its best to the coordinator (rank 0) and takes in whatever migrants have
+/// arrived, replacing its worst individuals. Rank 0 also tracks the global best and broadcasts the stop
+/// request once `stop_fitness` is reached.
+class IslandLink
+{
+public:
+    IslandLink(Transport& transport, const Parameters& p);
+
+    /// @brief Largest message payload an island of this configuration sends; the socket transport rejects bigger frames.
+    static std::size_t payloadLimit(const Parameters& p);
+
+    bool            due(int generation) const;
+
+    /// @return true when the coordinator asked every island to stop
+    template <typename T>
+    bool            exchange(Population<T>& population, const RunState& s);
+
+    /// @brief Reports the island's final best. On rank 0, waits for every island and returns the global best.
+    Chromosome      finish(const Chromosome& best);
+
+    int             rank() const { return m_transport.rank(); }
+
+private:
+    /// @brief Applies one message; a malformed one, or one from an island of another dimension, is logged and dropped.
+    template <typename T>
+    void            handle(Message& message, Population<T>* population, const RunState* s);
+    void            offerGlobalBest(Chromosome candidate);
+
+    Transport&        m_transport;
+    const Parameters& m_params;
+    std::size_t       m_dimensions;   // tamanho dos genomas aceitos de outras ilhas
+    int               m_interval;
+    int               m_migrants;
+    bool              m_stop{ false };
+
+    // Estado do coordenador (rank 0)
+    Chromosome        m_globalBest{};
+    bool              m_hasGlobalBest{ false };
+    bool              m_stopSent{ false };
+    std::vector<bool> m_finished{};
+};
@@ -0,0 +1,498 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <omp.h>
+#include "functions.hpp"
+#include "genetic_operators.h"
+#include "FunctionTransform.h"
+#include "crossover.h"
+#include "engines.h"
+#include "FlatPopulation.h"
+#include "MutationSchedule.h"
+#include "parallel_algorithms.h"
+#include "sampling.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    constexpr double bytesPerMiB{ 1024.0 * 1024.0 };
+
+    // Approximate footprint of one fitness cache entry (slot + hash index node)
+    constexpr std::size_t cacheEntryBytes{ 64 };
+
+    bool needsCdf(SelectionMethod method)
+    {
+        return method == SelectionMethod::fps || method == SelectionMethod::ranking;
+    }
+
+    /// @brief Per-generation selection state: the sorted order plus, for roulette methods, a cumulative distribution.
+    ///
+    /// The CDF is built once per generation with a parallel prefix sum, so every draw is a binary search
+    /// instead of rebuilding the roulette for each parent.
+    template <typename T>
+    class Selector
+    {
+    public:
+        Selector(const FlatPopulation<T>& population, const std::vector<std::uint32_t>& order, std::vector<double>& cdf,
+                 SelectionMethod method, int tournamentSize, int numThreads)
+            : m_population{ population }, m_order{ order }, m_cdf{ cdf }, m_method{ method }, m_tournamentSize{ std::max(1, tournamentSize) }
+        {
+            const std::size_t n{ population.size() };
+
+            if(m_method == SelectionMethod::fps)
+            {
+                const double maxFitness{ population.fitness(order[n - 1]) };
+
+                #pragma omp parallel for schedule(static) num_threads(numThreads)
+                for(std::size_t i = 0; i < n; ++i)
+                    m_cdf[i] = maxFitness - population.fitness(i) + 1e-6;
+
+                m_total = parallelPrefixSum(m_cdf.data(), n, numThreads);
+            }
+            else if(m_method == SelectionMethod::ranking)
+            {
+                // Mesmos pesos lineares da seleção por ranking da população em vetor
+                constexpr double min{ 0.8 };
+                constexpr double max{ 1.1 };
+                const double last{ static_cast<double>(std::max<std::size_t>(1, n - 1)) };
+
+                #pragma omp parallel for schedule(static) num_threads(numThreads)
+                for(std::size_t rank = 0; rank < n; ++rank)
+                    m_cdf[rank] = max - (max - min) * (static_cast<double>(rank) / last);
+
+                m_total = parallelPrefixSum(m_cdf.data(), n, numThreads);
+            }
+        }
+
+        std::size_t operator()() const
+        {
+            const std::size_t n{ m_population.size() };
+
+            if(m_method == SelectionMethod::tournament)
+            {
+                std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+                std::size_t winner{ pick(Random::mt) };
+
+                for(int i {1}; i < m_tournamentSize; ++i)
+                {
+                    const std::size_t candidate{ pick(Random::mt) };
+                    if(m_population.fitness(candidate) < m_population.fitness(winner))
+                        winner = candidate;
+                }
+
+                return winner;
+            }
+
+            if(needsCdf(m_method))
+            {
+                const double draw{ Random::uniform(0.0, m_total) };
+                const std::size_t position{ std::min<std::size_t>(n - 1,
+                    static_cast<std::size_t>(std::upper_bound(m_cdf.begin(), m_cdf.begin() + n, draw) - m_cdf.begin())) };
+
+                return m_method == SelectionMethod::ranking ? m_order[position] : position;
+            }
+
+            return m_order[0];
+        }
+
+    private:
+        const FlatPopulation<T>&          m_population;
+        const std::vector<std::uint32_t>& m_order;
+        std::vector<double>&              m_cdf;
+        SelectionMethod                   m_method;
+        int                               m_tournamentSize;
+        double                            m_total{};
+    };
+
+    template <typename T>
+    double evaluate(const T* genes, std::size_t n, Benchmark::FncPtr<T> fnc, FitnessCache* cache)
+    {
+        if(!cache)
+            return fnc(std::span<const T>(genes, n));
+
+        const FitnessCache::Key key{ FitnessCache::key(genes, n * sizeof(T)) };
+        double fitness{};
+
+        if(!cache->lookup(key, fitness))
+        {
+            fitness = fnc(std::span<const T>(genes, n));
+            cache->insert(key, fitness);
+        }
+
+        return fitness;
+    }
+
+    /// @brief Children per mutation block of a tile: even, in [2, 256], with the block's copies in about 64 KiB.
+    std::size_t mutationBlockRows(std::size_t n, std::size_t geneBytes)
+    {
+        constexpr std::size_t blockBytes{ 64 * 1024 };
+        return std::clamp<std::size_t>(blockBytes / std::max<std::size_t>(1, n * geneBytes), 2, 256) & ~std::size_t{ 1 };
+    }
+
+    /// @brief Gaussian mutation of a copy of each of `rows` contiguous children; a copy replaces its child only if it is better.
+    ///
+    /// The copies sit in one contiguous block, so the whole block is repaired in a single SearchBounds::repairBlock call.
+    /// @return number of mutated copies that replaced their child
+    template <typename T>
+    int mutateBlock(T* children, double* fitness, std::size_t rows, std::size_t n, const RunState& s, const SearchBounds& bounds, Benchmark::FncPtr<T> fnc)
+    {
+        thread_local std::vector<T> copies{};
+        thread_local std::vector<char> changed{};
+        copies.assign(children, children + rows * n);
+        changed.assign(rows, false);
+
+        std::normal_distribution<T> dist(0, static_cast<T>(s.mutation_strength));
+
+        for(std::size_t r {0}; r < rows; ++r)
+        {
+            T* copy{ copies.data() + r * n };
+            for(std::size_t j {0}; j < n; ++j)
+            {
+                if(Random::rand() < s.mutation_rate)
+                {
+                    copy[j] += dist(Random::mt);
+                    changed[r] = true;
+                }
+            }
+        }
+
+        // Cópias sem alteração são descartadas; repará-las junto não muda o resultado
+        bounds.repairBlock(copies.data(), rows, n);
+
+        int successes{ 0 };
+        for(std::size_t r {0}; r < rows; ++r)
+        {
+            if(!changed[r])
+                continue;
+
+            const T* copy{ copies.data() + r * n };
+            const double copyFitness{ evaluate(copy, n, fnc, s.cache) };
+
+            if(copyFitness < fitness[r])
+            {
+                std::copy(copy, copy + n, children + r * n);
+                fitness[r] = copyFitness;
+                ++successes;
+            }
+        }
+
+        return successes;
+    }
+
+    /// @brief Parents of one output tile, drawn up front and gathered into a resident buffer.
+    ///
+    /// Draws are sorted by index before gathering, so the source population is swept tile by tile
+    /// (the next tile is prefetched) instead of being hit at random; a shuffled pairing then restores
+    /// random mates. Sorting i.i.d. draws and pairing them at random leaves the selection unchanged.
+    template <typename T>
+    struct ParentBatch
+    {
+        std::vector<std::size_t> indices{};
+        std::vector<std::size_t> pairing{};
+        std::vector<T>           genes{};
+
+        void gather(const FlatPopulation<T>& population, const Selector<T>& select, std::size_t count)
+        {
+            const std::size_t n{ population.dimensions() };
+
+            indices.resize(count);
+            for(std::size_t& index : indices)
+                index = select();
+
+            std::sort(indices.begin(), indices.end());
+
+            genes.resize(count * n);
+            std::size_t currentTile{ population.numChunks() };
+
+            for(std::size_t k {0}; k < count; ++k)
+            {
+                const std::size_t tile{ indices[k] / FlatPopulation<T>::chunkSize };
+                if(tile != currentTile)
+                {
+                    currentTile = tile;
+                    const auto next{ std::upper_bound(indices.begin() + k, indices.end(), (tile + 1) * FlatPopulation<T>::chunkSize - 1) };
+                    if(next != indices.end())
+                        population.prefetch(*next / FlatPopulation<T>::chunkSize);
+                }
+
+                std::copy(population.genes(indices[k]), population.genes(indices[k]) + n, genes.begin() + k * n);
+            }
+
+            pairing.resize(count);
+            std::iota(pairing.begin(), pairing.end(), std::size_t{ 0 });
+            std::shuffle(pairing.begin(), pairing.end(), Random::mt);
+        }
+
+        const T* parent(std::size_t k, std::size_t n) const { return genes.data() + pairing[k] * n; }
+    };
+
+    template <typename T>
+    Chromosome toChromosome(const FlatPopulation<T>& population, std::size_t i, TargetFunction fnc)
+    {
+        const T* genes{ population.genes(i) };
+        BasicChromosome<T> individual{ std::vector<T>(genes, genes + population.dimensions()) };
+        individual.evaluate_solution(fnc);
+        return Chromosome(individual);
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+MemoryBudget MemoryBudget::estimate(const Parameters& p, int numThreads)
+{
+    const std::size_t n{ static_cast<std::size_t>(std::max(0, p.pop_size)) };
+    const std::size_t dims{ SearchBounds(p.target_function, p.dimensions, p.boundary_handling).size() };
+    const std::size_t geneBytes{ p.precision == Precision::float64 ? sizeof(double) : sizeof(float) };
+    const std::size_t batchRows{ std::min(n, FlatPopulation<double>::chunkSize) + 1 };
+
+    MemoryBudget budget{};
+    (p.out_of_core ? budget.mapped : budget.genes) = 2 * n * dims * geneBytes;
+    budget.fitness = 2 * n * sizeof(double);
+    budget.sort    = RadixSorter::bytesFor(n);
+    budget.cdf     = needsCdf(p.method) ? n * sizeof(double) : 0;
+    budget.batches = static_cast<std::size_t>(std::max(1, numThreads)) * batchRows * (dims * geneBytes + 2 * sizeof(std::size_t));
+    budget.cache   = static_cast<std::size_t>(std::max(0, p.fitness_cache_size)) * cacheEntryBytes;
+
+    return budget;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void printMemoryBudget(const Parameters& p, int numThreads)
+{
+    const MemoryBudget budget{ MemoryBudget::estimate(p, numThreads) };
+    const std::size_t total{ budget.total() };
+
+    const std::streamsize previousPrecision{ std::cout.precision(1) };
+
+    std::cout << "Large population memory budget (per run):\n";
+    if(p.out_of_core)
+        std::cout << "\t Genes (2 buffers, mapped tiles in '" << p.tile_directory << "'): " << budget.mapped / bytesPerMiB << " MiB on disk\n";
+    else
+        std::cout << "\t Genes (2 buffers): " << budget.genes / bytesPerMiB << " MiB\n";
+    std::cout << "\t Fitness (2 buffers): " << budget.fitness / bytesPerMiB << " MiB\n";
+    std::cout << "\t Sort keys and order: " << budget.sort / bytesPerMiB << " MiB\n";
+    std::cout << "\t Selection CDF: " << budget.cdf / bytesPerMiB << " MiB\n";
+    std::cout << "\t Parent batches (" << numThreads << " threads): " << budget.batches / bytesPerMiB << " MiB\n";
+    std::cout << "\t Fitness cache: " << budget.cache / bytesPerMiB << " MiB\n";
+    std::cout << "\t Resident total: " << total / bytesPerMiB << " MiB\n";
+
+#ifdef __linux__
+    const long pages{ sysconf(_SC_PHYS_PAGES) };
+    const long pageSize{ sysconf(_SC_PAGE_SIZE) };
+
+    if(pages > 0 && pageSize > 0)
+    {
+        const double physical{ static_cast<double>(pages) * static_cast<double>(pageSize) };
+        std::cout << "\t Physical memory: " << physical / bytesPerMiB << " MiB\n";
+
+        if(static_cast<double>(total) > physical)
+            std::cout << "\t Warning: the estimate exceeds physical memory\n";
+    }
+#endif
+
+    std::cout.precision(previousPrecision);
+    std::cout << std::endl;
+
+    if(p.memory_budget_mb > 0 && total > static_cast<std::size_t>(p.memory_budget_mb) * 1024 * 1024)
+    {
+        std::cerr << "Estimated memory exceeds memory_budget_mb=" << p.memory_budget_mb << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Generational GA over a FlatPopulation, for populations in the millions.
+///
+/// Same operators as geneticAlgorithm, but every O(N) step is a parallel pass over flat arrays:
+/// chunked initialization and evaluation, radix sort of the fitness keys, and one selection CDF
+/// per generation built with a parallel prefix sum. Offspring are produced one output tile at a time
+/// from a batch of parents gathered in index order, which keeps the out-of-core mode streaming.
+template <typename T>
+RunResult largePopulationGA(const Parameters& p, int numThreads)
+{
+    if(p.pop_size <= 1)
+        throw std::invalid_argument("Large population mode needs pop_size > 1.");
+
+    std::unique_ptr<FitnessCache> cache{ p.fitness_cache_size > 0 ? std::make_unique<FitnessCache>(p.fitness_cache_size) : nullptr };
+
+    const SearchBounds bounds{ p.target_function, p.dimensions, p.boundary_handling };
+    const std::size_t size{ static_cast<std::size_t>(p.pop_size) };
+    const std::size_t n{ bounds.size() };
+    const auto fnc{ Benchmark::objective<T>(p.target_function) };
+    const std::size_t numElites{ static_cast<std::size_t>(std::min(p.pop_size, std::max(1, static_cast<int>(p.elite_fraction * p.pop_size)))) };
+
+    const CrossoverSettings crossoverSettings{ CrossoverSettings::from(p, bounds) };
+
+    RunState state{};
+    state.cache = cache.get();
+
+    ConvergenceTrace trace{ p.trace_length };
+    state.trace = trace.enabled() ? &trace : nullptr;
+    std::vector<PopulationMoments> moments(static_cast<std::size_t>(std::max(1, numThreads)));
+
+    const std::string tileDirectory{ p.out_of_core ? p.tile_directory : std::string{} };
+    FlatPopulation<T> population(size, n, tileDirectory);
+    FlatPopulation<T> nextGeneration(size, n, tileDirectory);
+    RadixSorter sorter{};
+    std::vector<double> cdf(needsCdf(p.method) ? size : 0);
+
+    const std::uint64_t seed{ Random::seed() };
+    const UnitCubeSampler sampler{ p.init_sampling, n, size, seed };
+
+    // Inicialização e avaliação por bloco: cada bloco é tocado primeiro pela thread que o preenche
+    #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+    for(std::size_t chunk = 0; chunk < population.numChunks(); ++chunk)
+    {
+        std::mt19937 rng{ Random::stream(seed, chunk) };
+        std::vector<double> unit(n);
+
+        const std::size_t end{ std::min(size, (chunk + 1) * FlatPopulation<T>::chunkSize) };
+
+        for(std::size_t i {chunk * FlatPopulation<T>::chunkSize}; i < end; ++i)
+        {
+            sampler.point(i, unit.data(), rng);
+
+            T* genes{ population.genes(i) };
+            for(std::size_t j {0}; j < n; ++j)
+                genes[j] = static_cast<T>(bounds.lower(j) + unit[j] * (bounds.upper(j) - bounds.lower(j)));
+
+            population.fitness(i) = evaluate(genes, n, fnc, state.cache);
+        }
+
+        population.flush(chunk);
+    }
+
+    sorter.sort(population.fitness_array(), size, numThreads);
+
+    int generations{ p.nIterations };
+    StopReason stop{ StopReason::iterations };
+
+    for(int generation {0}; generation < p.nIterations; ++generation)
+    {
+        state.generation = generation;
+        updateMutationSchedule(p, state);
+
+        const std::vector<std::uint32_t>& order{ sorter.order() };
+        const Selector<T> select{ population, order, cdf, p.method, tournamentSize(p), numThreads };
+        const RunState& shared{ state };
+
+        // Elites copied in index order, so the source tiles are read sequentially
+        std::vector<std::uint32_t> elites(order.begin(), order.begin() + numElites);
+        std::sort(elites.begin(), elites.end());
+
+        if(state.trace)
+        {
+            for(PopulationMoments& partial : moments)
+                partial.reset(n);
+        }
+
+        #pragma omp parallel for schedule(static) num_threads(numThreads)
+        for(std::size_t i = 0; i < numElites; ++i)
+        {
+            std::copy(population.genes(elites[i]), population.genes(elites[i]) + n, nextGeneration.genes(i));
+            nextGeneration.fitness(i) = population.fitness(elites[i]);
+
+            if(shared.trace)
+                moments[omp_get_thread_num()].add(std::span<const T>(nextGeneration.genes(i), n), nextGeneration.fitness(i));
+        }
+
+        int successes{ 0 };
+        const std::size_t blockRows{ mutationBlockRows(n, sizeof(T)) };
+
+        // Uma tile de saída por vez em cada thread, com os pais dela reunidos em lote
+        #pragma omp parallel for schedule(dynamic) num_threads(numThreads) reduction(+:successes)
+        for(std::size_t tile = 0; tile < nextGeneration.numChunks(); ++tile)
+        {
+            const std::size_t first{ std::max(numElites, tile * FlatPopulation<T>::chunkSize) };
+            const std::size_t end  { std::min(size, (tile + 1) * FlatPopulation<T>::chunkSize) };
+
+            if(first >= end)
+                continue;
+
+            const std::size_t count{ end - first };
+
+            thread_local ParentBatch<T> batch{};
+            thread_local std::vector<T> spare{};
+            spare.resize(n);
+
+            batch.gather(population, select, count + (count & 1));
+
+            // Filhos da tile em blocos: crossover e avaliação, depois mutação e reparo do bloco inteiro
+            for(std::size_t blockFirst {0}; blockFirst < count; blockFirst += blockRows)
+            {
+                const std::size_t blockEnd{ std::min(count, blockFirst + blockRows) };
+
+                for(std::size_t k {blockFirst}; k < blockEnd; k += 2)
+                {
+                    const bool both{ k + 1 < count };
+                    const T* parent1{ batch.parent(k, n) };
+                    const T* parent2{ batch.parent(k + 1, n) };
+
+                    T* child1{ nextGeneration.genes(first + k) };
+                    T* child2{ both ? nextGeneration.genes(first + k + 1) : spare.data() };
+
+                    crossoverPair(parent1, parent2, child1, child2, n, p.points, crossoverSettings);
+
+                    nextGeneration.fitness(first + k) = evaluate(child1, n, fnc, shared.cache);
+                    if(both)
+                        nextGeneration.fitness(first + k + 1) = evaluate(child2, n, fnc, shared.cache);
+                }
+
+                const std::size_t rows{ blockEnd - blockFirst };
+                successes += mutateBlock(nextGeneration.genes(first + blockFirst), &nextGeneration.fitness(first + blockFirst), rows, n, shared, bounds, fnc);
+
+                if(shared.trace)
+                {
+                    for(std::size_t i {first + blockFirst}; i < first + blockEnd; ++i)
+                        moments[omp_get_thread_num()].add(std::span<const T>(nextGeneration.genes(i), n), nextGeneration.fitness(i));
+                }
+            }
+
+            nextGeneration.flush(tile);
+        }
+
+        state.mutation_attempts = static_cast<int>(size - numElites);
+        state.mutation_successes = successes;
+
+        if(state.trace)
+        {
+            for(std::size_t t {1}; t < moments.size(); ++t)
+                moments[0] += moments[t];
+            state.trace->record(moments[0].stats(generation, state.mutation_rate, state.mutation_strength));
+        }
+
+        std::swap(population, nextGeneration);
+        sorter.sort(population.fitness_array(), size, numThreads);
+
+        // Imprimir a cada 100 gerações
+        if((generation + 1) % 100 == 0 || generation == p.nIterations - 1)
+            printSolution(toChromosome(population, sorter.order()[0], p.target_function), generation);
+
+        if(p.stop_at_fitness && population.fitness_array()[sorter.order()[0]] <= p.stop_fitness)
+        {
+            printSolution(toChromosome(population, sorter.order()[0], p.target_function), generation);
+            generations = generation + 1;
+            stop = StopReason::stop_fitness;
+            break;
+        }
+    }
+
+    RunResult result{ toChromosome(population, sorter.order()[0], p.target_function), cache ? cache->stats() : CacheStats{}, generations, stop };
+    result.trace = trace.chronological();
+
+    return result;
+}
+
+template RunResult largePopulationGA<float>(const Parameters&, int);
+template RunResult largePopulationGA<double>(const Parameters&, int);
@@ -0,0 +1,443 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+#include <omp.h>
+#include "local_search.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    void clampPoint(std::vector<double>& x, const SearchBounds& bounds)
+    {
+        for(std::size_t i {0}; i < x.size(); ++i)
+            x[i] = std::clamp(x[i], bounds.lower(i), bounds.upper(i));
+    }
+
+    double dot(const std::vector<double>& a, const std::vector<double>& b)
+    {
+        return std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+    }
+
+    /// @brief Forward-difference gradient; steps backwards on a coordinate sitting on its upper bound.
+    void gradient(const std::vector<double>& x, double fx, Benchmark::FncPtr<double> evaluate, const SearchBounds& bounds,
+                  std::vector<double>& probe, std::vector<double>& g)
+    {
+        probe = x;
+        for(std::size_t i {0}; i < x.size(); ++i)
+        {
+            double h{ 1e-7 * std::max(1.0, std::abs(x[i])) };
+            if(x[i] + h > bounds.upper(i))
+                h = -h;
+
+            probe[i] = x[i] + h;
+            g[i] = (evaluate(probe) - fx) / h;
+            probe[i] = x[i];
+        }
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Hooke-Jeeves style coordinate pattern search.
+///
+/// Tries +/- step along every coordinate, keeps any improvement and halves the step when a
+/// full sweep fails.
+int coordinateDescent(LocalPoint& point, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations)
+{
+    const std::size_t n{ point.x.size() };
+    const auto evaluate{ Benchmark::objective<double>(fnc) };
+
+    std::vector<double>& x{ point.x };
+    std::vector<double> step(n);
+    for(std::size_t i {0}; i < n; ++i)
+        step[i] = initialStep * (bounds.upper(i) - bounds.lower(i));
+
+    double best{ point.fitness };
+    int evaluations{ 0 };
+
+    while(evaluations < maxEvaluations)
+    {
+        bool improved{ false };
+
+        for(std::size_t i {0}; i < n && evaluations < maxEvaluations; ++i)
+        {
+            for(double direction : { 1.0, -1.0 })
+            {
+                const double previous{ x[i] };
+                x[i] = std::clamp(previous + direction * step[i], bounds.lower(i), bounds.upper(i));
+
+                const double candidate{ evaluate(x) };
+                ++evaluations;
+
+                if(candidate < best)
+                {
+                    best = candidate;
+                    improved = true;
+                    break;
+                }
+
+                x[i] = previous;
+            }
+        }
+
+        if(!improved)
+        {
+            for(double& s : step)
+                s *= 0.5;
+
+            if(*std::max_element(step.begin(), step.end()) < 1e-15)
+                break;
+        }
+    }
+
+    point.fitness = best;
+
+    return evaluations;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Nelder-Mead simplex (reflection 1, expansion 2, contraction and shrink 0.5), vertices clamped to the bounds.
+int nelderMead(LocalPoint& point, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations)
+{
+    const std::size_t n{ point.x.size() };
+    const auto evaluate{ Benchmark::objective<double>(fnc) };
+
+    std::vector<std::vector<double>> simplex(n + 1, point.x);
+    std::vector<double> values(n + 1, point.fitness);
+    int evaluations{ 0 };
+
+    // Simplex inicial: um passo ao longo de cada eixo, para dentro dos limites
+    for(std::size_t i {0}; i < n && evaluations < maxEvaluations; ++i)
+    {
+        const double step{ initialStep * (bounds.upper(i) - bounds.lower(i)) };
+        simplex[i + 1][i] = point.x[i] + step <= bounds.upper(i) ? point.x[i] + step : point.x[i] - step;
+        clampPoint(simplex[i + 1], bounds);
+        values[i + 1] = evaluate(simplex[i + 1]);
+        ++evaluations;
+    }
+
+    std::vector<std::size_t> order(n + 1);
+    std::vector<double> centroid(n), reflected(n), trial(n);
+
+    const auto along{ [&](double t, std::vector<double>& out, const std::vector<double>& worst) {
+        for(std::size_t j {0}; j < n; ++j)
+            out[j] = centroid[j] + t * (worst[j] - centroid[j]);
+        clampPoint(out, bounds);
+    } };
+
+    while(evaluations < maxEvaluations)
+    {
+        std::iota(order.begin(), order.end(), std::size_t{ 0 });
+        std::sort(order.begin(), order.end(), [&values](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+
+        const std::size_t best{ order.front() };
+        const std::size_t worst{ order.back() };
+        const std::size_t second{ order[n - 1] };
+
+        if(std::abs(values[worst] - values[best]) <= 1e-15 * (std::abs(values[best]) + 1e-300))
+            break;
+
+        std::fill(centroid.begin(), centroid.end(), 0.0);
+        for(std::size_t k : order)
+            if(k != worst)
+                for(std::size_t j {0}; j < n; ++j)
+                    centroid[j] += simplex[k][j] / static_cast<double>(n);
+
+        along(-1.0, reflected, simplex[worst]);
+        const double fr{ evaluate(reflected) };
+        ++evaluations;
+
+        if(fr < values[best])
+        {
+            along(-2.0, trial, simplex[worst]);
+            const double fe{ evaluations < maxEvaluations ? evaluate(trial) : fr };
+            ++evaluations;
+
+            if(fe < fr)
+            {
+                simplex[worst] = trial;
+                values[worst]  = fe;
+            }
+            else
+            {
+                simplex[worst] = reflected;
+                values[worst]  = fr;
+            }
+            continue;
+        }
+
+        if(fr < values[second])
+        {
+            simplex[worst] = reflected;
+            values[worst]  = fr;
+            continue;
+        }
+
+        // Contração para fora (reflexão melhor que o pior) ou para dentro
+        const bool outside{ fr < values[worst] };
+        along(outside ? -0.5 : 0.5, trial, simplex[worst]);
+        const double fc{ evaluate(trial) };
+        ++evaluations;
+
+        if(fc < std::min(fr, values[worst]))
+        {
+            simplex[worst] = trial;
+            values[worst]  = fc;
+            continue;
+        }
+
+        // Encolhe tudo em direção ao melhor vértice
+        for(std::size_t k {0}; k <= n && evaluations < maxEvaluations; ++k)
+        {
+            if(k == best)
+                continue;
+            for(std::size_t j {0}; j < n; ++j)
+                simplex[k][j] = simplex[best][j] + 0.5 * (simplex[k][j] - simplex[best][j]);
+            values[k] = evaluate(simplex[k]);
+            ++evaluations;
+        }
+    }
+
+    const std::size_t best{ static_cast<std::size_t>(std::min_element(values.begin(), values.end()) - values.begin()) };
+    if(values[best] < point.fitness)
+    {
+        point.x       = simplex[best];
+        point.fitness = values[best];
+    }
+
+    return evaluations;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Limited-memory BFGS (6 pairs) with forward-difference gradients and a projected Armijo backtracking line search.
+int lbfgs(LocalPoint& point, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations)
+{
+    constexpr std::size_t memory{ 6 };
+    constexpr int maxBacktracks{ 30 };
+
+    const std::size_t n{ point.x.size() };
+    const auto evaluate{ Benchmark::objective<double>(fnc) };
+
+    std::vector<double> x{ point.x };
+    double fx{ point.fitness };
+
+    std::vector<double> g(n), gNext(n), d(n), xNext(n), probe(n), alpha(memory);
+    std::vector<std::vector<double>> sHistory{}, yHistory{};
+    std::vector<double> rhoHistory{};
+
+    int evaluations{ 0 };
+    if(maxEvaluations < static_cast<int>(n) + 2)
+        return evaluations;
+
+    gradient(x, fx, evaluate, bounds, probe, g);
+    evaluations += static_cast<int>(n);
+
+    // Primeiro passo limitado a initialStep da largura média, antes de haver curvatura estimada
+    double width{ 0.0 };
+    for(std::size_t i {0}; i < n; ++i)
+        width += (bounds.upper(i) - bounds.lower(i)) / static_cast<double>(n);
+
+    while(evaluations + 1 < maxEvaluations)
+    {
+        // Recursão em dois laços: d = -H g
+        d = g;
+        for(std::size_t k {sHistory.size()}; k-- > 0;)
+        {
+            alpha[k] = rhoHistory[k] * dot(sHistory[k], d);
+            for(std::size_t j {0}; j < n; ++j)
+                d[j] -= alpha[k] * yHistory[k][j];
+        }
+
+        double scale{ 1.0 };
+        if(!sHistory.empty())
+            scale = dot(sHistory.back(), yHistory.back()) / dot(yHistory.back(), yHistory.back());
+        else
+        {
+            const double norm{ std::sqrt(dot(g, g)) };
+            scale = norm > 0.0 ? initialStep * width / norm : 0.0;
+        }
+
+        for(double& v : d)
+            v *= scale;
+        for(std::size_t k {0}; k < sHistory.size(); ++k)
+        {
+            const double beta{ rhoHistory[k] * dot(yHistory[k], d) };
+            for(std::size_t j {0}; j < n; ++j)
+                d[j] += sHistory[k][j] * (alpha[k] - beta);
+        }
+        for(double& v : d)
+            v = -v;
+
+        if(!(dot(g, d) < 0.0))
+        {
+            if(sHistory.empty())
+                break;
+
+            // Direção sem descida: recomeça pelo gradiente
+            sHistory.clear();
+            yHistory.clear();
+            rhoHistory.clear();
+            continue;
+        }
+
+        double step{ 1.0 };
+        double fNext{ fx };
+        bool accepted{ false };
+
+        for(int tries {0}; tries < maxBacktracks && evaluations < maxEvaluations; ++tries, step *= 0.5)
+        {
+            double decrease{ 0.0 };
+            for(std::size_t j {0}; j < n; ++j)
+            {
+                xNext[j] = std::clamp(x[j] + step * d[j], bounds.lower(j), bounds.upper(j));
+                decrease += g[j] * (xNext[j] - x[j]);
+            }
+
+            fNext = evaluate(xNext);
+            ++evaluations;
+
+            if(fNext <= fx + 1e-4 * decrease && fNext < fx)
+            {
+                accepted = true;
+                break;
+            }
+        }
+
+        if(!accepted || evaluations + static_cast<int>(n) > maxEvaluations)
+        {
+            if(accepted)
+            {
+                x.swap(xNext);
+                fx = fNext;
+            }
+            break;
+        }
+
+        gradient(xNext, fNext, evaluate, bounds, probe, gNext);
+        evaluations += static_cast<int>(n);
+
+        std::vector<double> s(n), y(n);
+        for(std::size_t j {0}; j < n; ++j)
+        {
+            s[j] = xNext[j] - x[j];
+            y[j] = gNext[j] - g[j];
+        }
+
+        // Só guarda pares com curvatura positiva, para H continuar definida positiva
+        const double sy{ dot(s, y) };
+        if(sy > 1e-12 * std::sqrt(dot(s, s) * dot(y, y)))
+        {
+            if(sHistory.size() == memory)
+            {
+                sHistory.erase(sHistory.begin());
+                yHistory.erase(yHistory.begin());
+                rhoHistory.erase(rhoHistory.begin());
+            }
+            sHistory.push_back(std::move(s));
+            yHistory.push_back(std::move(y));
+            rhoHistory.push_back(1.0 / sy);
+        }
+
+        x.swap(xNext);
+        fx = fNext;
+        g.swap(gNext);
+    }
+
+    if(fx < point.fitness)
+    {
+        point.x       = std::move(x);
+        point.fitness = fx;
+    }
+
+    return evaluations;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+int localSearch(LocalSearch method, LocalPoint& point, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations)
+{
+    switch(method)
+    {
+        case LocalSearch::coordinate:
+            return coordinateDescent(point, fnc, bounds, initialStep, maxEvaluations);
+        case LocalSearch::nelder_mead:
+            return nelderMead(point, fnc, bounds, initialStep, maxEvaluations);
+        case LocalSearch::lbfgs:
+            return lbfgs(point, fnc, bounds, initialStep, maxEvaluations);
+        default:
+            return 0;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Coordinate pattern search of a single solution in double precision. `solution` must already be evaluated.
+/// @return number of function evaluations spent
+int patternSearch(Chromosome& solution, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations)
+{
+    LocalPoint point{ solution.get_genes_array(), solution.get_fitness() };
+
+    const int evaluations{ coordinateDescent(point, fnc, bounds, initialStep, maxEvaluations) };
+
+    if(point.fitness < solution.get_fitness())
+    {
+        solution = Chromosome(std::move(point.x));
+        solution.evaluate_solution(fnc);
+    }
+
+    return evaluations;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+int refineElites(Population<T>& population, const Parameters& p, const SearchBounds& bounds, const RunState& s, int numThreads)
+{
+    const int elites{ std::clamp(p.local_search_elites > 0 ? p.local_search_elites : 4, 1, static_cast<int>(population.size())) };
+    const int dimensions{ static_cast<int>(bounds.size()) };
+    const int budget{ p.local_search_evaluations > 0 ? p.local_search_evaluations : 100 * dimensions };
+    const int perElite{ std::max(2 * dimensions + 2, budget / elites) };
+
+    // Passo inicial na escala da mutação atual, relativo à largura média do domínio
+    double width{ 0.0 };
+    for(std::size_t i {0}; i < bounds.size(); ++i)
+        width += (bounds.upper(i) - bounds.lower(i)) / static_cast<double>(bounds.size());
+    const double initialStep{ std::clamp(s.mutation_strength / width, 1e-8, 0.1) };
+
+    int evaluations{ 0 };
+
+    #pragma omp parallel for schedule(dynamic) num_threads(numThreads) reduction(+:evaluations) if(numThreads > 1)
+    for(int i = 0; i < elites; ++i)
+    {
+        BasicChromosome<T>& elite{ population[i] };
+        LocalPoint point{ std::vector<double>(elite.genes().begin(), elite.genes().end()), elite.get_fitness() };
+        if constexpr (!std::is_same_v<T, double>)
+        {
+            point.fitness = Benchmark::objective<double>(p.target_function)(point.x);
+            ++evaluations;
+        }
+
+        evaluations += localSearch(p.local_search, point, p.target_function, bounds, initialStep, perElite);
+
+        // De volta à precisão dos genes; só substitui se continuar melhor depois do arredondamento
+        BasicChromosome<T> refined{ std::vector<T>(point.x.begin(), point.x.end()) };
+        refined.evaluate_solution(p.target_function, s.cache);
+
+        if(refined.get_fitness() < elite.get_fitness())
+            elite = std::move(refined);
+    }
+
+    std::sort(population.begin(), population.end());
+
+    return evaluations;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template int refineElites<float>(Population<float>&, const Parameters&, const SearchBounds&, const RunState&, int);
+template int refineElites<double>(Population<double>&, const Parameters&, const SearchBounds&, const RunState&, int);
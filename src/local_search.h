@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+#include "Chromosome.h"
+#include "SearchBounds.h"
+#include "Parameters.h"
+#include "RunState.h"
+
+// Derivative-free and quasi-Newton local optimizers, used by the mixed precision polish and by the memetic
+// GA (`local_search` key). All of them work on a double copy of the genes, stay inside the bounds and
+// return the number of function evaluations spent; the point is only changed when it improves.
+
+struct LocalPoint
+{
+    std::vector<double> x{};
+    double              fitness{};   // must already hold f(x)
+};
+
+/// @param initialStep first step, as a fraction of each dimension's width
+int coordinateDescent(LocalPoint& point, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations);
+int nelderMead(LocalPoint& point, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations);
+int lbfgs(LocalPoint& point, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations);
+int localSearch(LocalSearch method, LocalPoint& point, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations);
+
+int patternSearch(Chromosome& solution, TargetFunction fnc, const SearchBounds& bounds, double initialStep, int maxEvaluations);
+
+/// @brief Memetic step: refines the `local_search_elites` best individuals of a sorted population in parallel.
+/// @return evaluations spent
+template <typename T>
+int refineElites(Population<T>& population, const Parameters& p, const SearchBounds& bounds, const RunState& s, int numThreads);
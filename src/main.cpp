@@ -1,5 +1,12 @@
+#include <array>
+#include <cstdlib>
+#include <exception>
 #include <iostream>
+#include <numeric>
 #include <vector>
+#include <memory>
+#include <string_view>
+#include <thread>
 #include <omp.h>
 #include "constants.h"
 #include "Utils.h"
@@ -8,13 +15,23 @@
 #include "Timer.h"
 #include "genetic_operators.h"
 #include "FileLoader.h"
+#include "RunResult.h"
+#include "engines.h"
+#include "MutationSchedule.h"
+#include "FlatPopulation.h"
+#include "island.h"
+#include "ResultsSink.h"
+#include "ParallelTuner.h"
+#include "multi_objective.h"
+#include "PerfCounters.h"
+#include "FunctionTransform.h"
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-void printSolution(const Chromosome& solution, int generation);
-void printResults(std::vector<Chromosome>& solutions, const Parameters& p);
-void adjustParallelPopulation(Parameters& p);
-Chromosome geneticAlgorithm(Parameters& p, int numThreads, bool parallel);
+void printResults(std::vector<RunResult>& results, const Parameters& p);
+void printPerfCounters(const PerfProfile& profile);
+RunResult runEngine(const Parameters& p, int numThreads, bool parallel, IslandLink* island = nullptr);
+std::vector<RunResult> runIslands(const Parameters& p, int maxThreads);
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
@@ -34,8 +51,26 @@ int main(int argc, char* argv[])
       else 
       {
          std::string configFilePath{ arg1 };
+#ifdef _WIN32
          std::replace(configFilePath.begin(), configFilePath.end(), '/', '\\');
-         params = FileLoader::loadFromTXT(configFilePath);
+#endif
+         try
+         {
+            params = FileLoader::loadFromTXT(configFilePath);
+         }
+         catch(const std::exception& e)
+         {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+         }
+
+         // O mesmo arquivo de configuração serve para todos os processos: o rank pode vir da linha de comando
+         for(int i {2}; i < argc; ++i)
+         {
+            const std::string_view arg{ argv[i] };
+            if(arg.starts_with("--rank="))
+               params.island_rank = std::stoi(std::string{ arg.substr(7) });
+         }
       }
    } 
    else 
@@ -47,41 +82,85 @@ int main(int argc, char* argv[])
 
    Settings::setup_precision(params.print_precision);
    const int maxThreads{ Settings::MultiThread::maxThreads };
-   const bool populationParallelThreshold{ (params.pop_size >= Settings::MultiThread::POPULATION_PARALLEL_THRESHOLD) || (params.dimensions >= 20) };
-   /**/bool sphereBug{ populationParallelThreshold && (params.target_function == TargetFunction::sphere) && params.dimensions > 3 };/**/
    omp_set_nested(1);  
    omp_set_num_threads(maxThreads);
 
-   if(populationParallelThreshold && (params.pop_size & 1))
-      adjustParallelPopulation(params);
+   // Variante deslocada/girada da função: gerada uma vez e compartilhada por todas as execuções
+   if(params.transform != TransformType::none && params.engine != Engine::nsga2)
+   {
+      const SearchBounds bounds{ params.target_function, params.dimensions };
+      FunctionTransform::install(FunctionTransform{ params.target_function, bounds.size(), bounds.lower_array(), bounds.upper_array(),
+                                                    params.transform, params.transform_seed != 0 ? params.transform_seed : 1 });
+   }
 
-   std::vector<Chromosome> topSolutions(params.num_tests);
+   std::vector<RunResult> topSolutions(params.num_tests);
 
-   int remainingTests{ params.num_tests };
-   Timer t;
-   #pragma omp parallel for schedule(static) num_threads(maxThreads)
-   for(int i = 0; i < params.num_tests; ++i)
+   // Cada execução vai para o arquivo assim que termina, escrita por uma thread própria
+   std::unique_ptr<ResultsSink> sink{ params.results_file.empty() ? nullptr : std::make_unique<ResultsSink>(resultsPath(params), params.results_format, params.trace_length > 0) };
+
+   // Populações enormes: um teste por vez, cada um com todas as threads
+   if(params.large_population)
+      printMemoryBudget(params, maxThreads);
+
+   // Divisão das threads entre testes e dentro de cada teste, medida na configuração real
+   ParallelPlan plan{};
+   if(params.islands <= 1 && !params.large_population)
    {
-      bool should_parallelize { 
-         (populationParallelThreshold) &&
-         (maxThreads % remainingTests == 0) && 
-         (remainingTests < maxThreads) && 
-         !(sphereBug) 
-      };
+      plan = tuneParallelism(params, maxThreads);
+      printParallelPlan(plan, params);
+      params.parallel_chunk = plan.chunkSize;
+   }
 
-      int numThreads{ (remainingTests==1) ? maxThreads : maxThreads / 2 }; 
+   // Contadores só depois do ajuste, que roda gerações de teste
+   if(params.perf_counters)
+      PerfCounters::enable();
 
-      Chromosome bestSolution{ geneticAlgorithm(params, numThreads, should_parallelize) };
-      topSolutions[i] = bestSolution;
+   Timer t;
+   if(params.islands > 1)
+   {
+      topSolutions = runIslands(params, maxThreads);
 
-      #pragma omp critical
+      if(sink)
       {
-         --remainingTests;
+         for(std::size_t i {0}; i < topSolutions.size(); ++i)
+            sink->push(static_cast<int>(i), topSolutions[i]);
+      }
+   }
+   else if(params.large_population)
+   {
+      for(int i = 0; i < params.num_tests; ++i)
+      {
+         if(params.seed != 0)
+            Random::mt = Random::stream(params.seed, static_cast<std::uint64_t>(i));
+
+         topSolutions[i] = runEngine(params, maxThreads, true);
+         if(sink)
+            sink->push(i, topSolutions[i]);
+      }
+   }
+   else
+   {
+      #pragma omp parallel for schedule(dynamic) num_threads(plan.concurrentTests)
+      for(int i = 0; i < params.num_tests; ++i)
+      {
+         // Semente fixa: cada teste recebe o seu fluxo, independente de qual thread o executa
+         if(params.seed != 0)
+            Random::mt = Random::stream(params.seed, static_cast<std::uint64_t>(i));
+
+         topSolutions[i] = runEngine(params, plan.threadsPerTest, plan.threadsPerTest > 1);
+         if(sink)
+            sink->push(i, topSolutions[i]);
       }
    }
 
    auto time{ t.elapsed() };
 
+   if(sink)
+      sink->close();
+
+   if(params.engine == Engine::nsga2 && !params.pareto_file.empty())
+      writeParetoFronts(params.pareto_file, topSolutions);
+
    printResults(topSolutions, params);
 
    printElapsedTime(time);
@@ -92,61 +171,191 @@ int main(int argc, char* argv[])
 
 // -------------------------------------------------------------------------------------------------------------------------------------
 
-Chromosome geneticAlgorithm(Parameters& p, int numThreads, bool parallel)
+/// @brief Runs one test with the configured engine and records its wall time.
+RunResult runEngine(const Parameters& p, int numThreads, bool parallel, IslandLink* island)
 {
-   std::vector<Chromosome> population{ initialization(p.target_function, p.dimensions, p.pop_size) };
-   
-   evaluatePopulation(population, p.target_function);
+   Timer timer;
+   RunResult result{ runOptimizer(p, numThreads, parallel, island) };
+   result.seconds = timer.elapsed();
 
-   std::sort(population.begin(), population.end());
+   return result;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
 
-   for(int generation {0}; generation < p.nIterations; ++generation)
+/// @brief Runs every island of the distributed model that lives in this process.
+///
+/// With the loopback transport all `islands` run here as threads sharing the cores; with sockets this
+/// process runs only island `island_rank` (rank 0 also coordinates and reports the global best).
+std::vector<RunResult> runIslands(const Parameters& p, int maxThreads)
+{
+   if(p.transport == TransportType::loopback)
    {
-      auto linearDecay = [generation, &p](double initial_rate, double final_rate) {
-         return initial_rate - (static_cast<double>(generation) / p.nIterations) * (initial_rate - final_rate);
-      };
+      LoopbackHub hub{ p.islands };
+      std::vector<RunResult> results(p.islands);
+      const int threadsPerIsland{ std::max(1, maxThreads / p.islands) };
 
-      p.mutation_rate = linearDecay(p.initial_mutation_rate, p.final_mutation_rate);
-      p.mutation_strength = linearDecay(p.initial_mutation_strength, p.final_mutation_strength);
+      // Threads próprias: todas as ilhas precisam rodar ao mesmo tempo para trocar migrantes
+      std::vector<std::thread> workers;
+      for(int rank {0}; rank < p.islands; ++rank)
+      {
+         workers.emplace_back([&p, &hub, &results, rank, threadsPerIsland]
+         {
+            LoopbackTransport transport{ hub, rank };
+            IslandLink island{ transport, p };
 
-      if(parallel)
-         population = parallelCreateNewGeneration(population, p, numThreads);
-      else
-         population = createNewGeneration(population, p);
-        
-      // Imprimir a cada 100 gerações
-      if((generation + 1) % 100 == 0 || generation == p.nIterations - 1)
-         printSolution(population[BEST_SOLUTION], generation);
+            results[rank] = runEngine(p, threadsPerIsland, threadsPerIsland > 1, &island);
+            results[rank].best = island.finish(results[rank].best);
+         });
+      }
+
+      for(std::thread& worker : workers)
+         worker.join();
+
+      return results;
    }
 
-   return population[BEST_SOLUTION];
-}
+   SocketTransport transport{ p.transport, p.coordinator_address, p.island_rank, p.islands, IslandLink::payloadLimit(p) };
+   IslandLink island{ transport, p };
 
-void printSolution(const Chromosome& solution, int generation)
-{
-   std::cout << "Generation: " << generation + 1 << '\n';
-   std::cout << "\tGenes: ";
-   std::cout << solution << '\n';
-   std::cout << "\tFitness: " << solution.get_fitness() << '\n';
+   RunResult result{ runEngine(p, maxThreads, maxThreads > 1, &island) };
+   result.best = island.finish(result.best);
+
+   return { result };
 }
 
-void printResults(std::vector<Chromosome>& solutions, const Parameters& p)
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void printResults(std::vector<RunResult>& results, const Parameters& p)
 {
-   std::sort(solutions.begin(), solutions.end());
+   // Os blocos de estatísticas mudam a precisão; o que vem depois (tempo total) usa a do chamador
+   const std::ios_base::fmtflags flags{ std::cout.flags() };
+   const std::streamsize precision{ std::cout.precision() };
+
+   std::sort(results.begin(), results.end());
+   const Chromosome& best{ results[BEST_SOLUTION].best };
 
    std::cout << "\n\n\n\n\t\tResults:\n\n";
 
-   std::cout << "Benchmark Function: " << p.target_function << '\n';
+   if(p.engine == Engine::nsga2)
+      std::cout << "Objective Function: " << p.objective_function << " (" << objectiveCount(p) << " objectives)\n";
+   else
+   {
+      std::cout << "Benchmark Function: " << p.target_function;
+      if(p.transform != TransformType::none)
+         std::cout << " (" << p.transform << ')';
+      std::cout << '\n';
+   }
+   std::cout << "Engine: " << p.engine << '\n';
+   if(p.islands > 1)
+      std::cout << "Islands: " << p.islands << (p.transport == TransportType::loopback ? " (loopback)" : " (island " + std::to_string(p.island_rank) + ")") << '\n';
+   if(p.engine == Engine::ga)
+      std::cout << "Precision: " << p.precision << '\n';
 
    std::cout << "Best Solution Found:\n";
-   std::cout << "\t Genes: " << solutions[BEST_SOLUTION];
-   std:: cout << "\n\t Fitness: " << solutions[BEST_SOLUTION].get_fitness();
+   std::cout << "\t Genes: " << best;
+   std:: cout << "\n\t Fitness: " << best.get_fitness();
+
+   if(p.engine == Engine::nsga2)
+   {
+      // Até 10 pontos espaçados ao longo da frente, ordenada pelo primeiro objetivo
+      const ParetoFront& front{ results[BEST_SOLUTION].pareto };
+      std::vector<std::size_t> order(front.size());
+      std::iota(order.begin(), order.end(), std::size_t{ 0 });
+      std::sort(order.begin(), order.end(), [&front](std::size_t a, std::size_t b) { return front.values[a * front.objectives] < front.values[b * front.objectives]; });
+
+      std::cout << "\n\nPareto front: " << front.size() << " solutions (of the run with the lowest first objective)";
+      const std::size_t shown{ std::min<std::size_t>(10, front.size()) };
+      for(std::size_t k {0}; k < shown; ++k)
+      {
+         const std::size_t i{ order[shown > 1 ? k * (front.size() - 1) / (shown - 1) : 0] };
+         std::cout << "\n\t (";
+         for(std::size_t j {0}; j < front.objectives; ++j)
+            std::cout << (j ? ", " : "") << front.values[i * front.objectives + j];
+         std::cout << ')';
+      }
+
+      if(!p.pareto_file.empty())
+         std::cout << "\n\nPareto fronts of every run written to: " << p.pareto_file;
+   }
+
+   if(p.surrogate != SurrogateType::none && p.engine == Engine::ga && !p.large_population)
+   {
+      SurrogateStats total{};
+      for(const auto& result : results)
+         total += result.surrogate;
+
+      std::cout << "\n\nSurrogate pre-screening (" << p.surrogate << "):\n";
+      std::cout << "\t Evaluated children: " << total.evaluated << "  Screened out: " << total.screened;
+      std::cout << "\n\t Evaluations saved: " << std::setprecision(2) << 100.0 * total.savedRate() << '%';
+   }
+
+   if(p.fitness_cache_size > 0)
+   {
+      CacheStats total{};
+      for(const auto& result : results)
+         total += result.cache;
+
+      std::cout << "\n\nFitness cache (" << p.fitness_cache_size << " entries per run):\n";
+      std::cout << "\t Hits: " << total.hits << "  Misses: " << total.misses << "  Evictions: " << total.evictions;
+      std::cout << "\n\t Hit rate: " << std::setprecision(2) << 100.0 * total.hitRate() << '%';
+   }
+
+   if(p.perf_counters && p.engine == Engine::ga && !p.large_population)
+      printPerfCounters(PerfCounters::collect());
+
+   if(!p.results_file.empty())
+   {
+      std::cout << "\n\nRun results written to: " << resultsPath(p) << " (" << (p.results_format == ResultsFormat::csv ? "csv" : "binary") << ')';
+      if(p.trace_length > 0)
+         std::cout << "\nConvergence traces written to: " << traceFilePath(resultsPath(p));
+   }
+
+   std::cout.flags(flags);
+   std::cout.precision(precision);
 }
 
-/// @brief Parallelized code doesn't work if odd population number.
-///
-/// This function increases population size by one.
-void adjustParallelPopulation(Parameters& p)
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void printPerfCounters(const PerfProfile& profile)
 {
-   p.pop_size += 1;
+   constexpr std::array<const char*, gaPhaseCount> phaseNames{ "selection", "crossover", "mutation", "evaluation", "sort" };
+
+   if(!profile.any())
+   {
+      std::cout << "\n\nHardware counters unavailable: " << (profile.error.empty() ? "no phase was sampled" : profile.error);
+      return;
+   }
+
+   std::uint64_t totalTime{ 0 };
+   for(const PhaseCounters& phase : profile.phases)
+      totalTime += phase.values[static_cast<std::size_t>(PerfEvent::task_clock)];
+
+   // Valor negativo: evento indisponível nesta máquina
+   const auto cell{ [](double value, int width) {
+      if(value < 0.0)
+         std::cout << std::setw(width) << "n/a";
+      else
+         std::cout << std::setw(width) << std::setprecision(2) << value;
+   } };
+
+   std::cout << "\n\nHardware counters (user space, all worker threads, per individual):\n";
+   std::cout << "\t " << std::left << std::setw(12) << "Phase" << std::right << std::setw(8) << "Time %" << std::setw(8) << "IPC"
+             << std::setw(15) << "Cache misses" << std::setw(15) << "Branch misses" << std::setw(12) << "LLC loads";
+
+   for(std::size_t i {0}; i < gaPhaseCount; ++i)
+   {
+      const GaPhase phase{ static_cast<GaPhase>(i) };
+      const double time{ static_cast<double>(profile.phases[i].values[static_cast<std::size_t>(PerfEvent::task_clock)]) };
+
+      std::cout << "\n\t " << std::left << std::setw(12) << phaseNames[i] << std::right;
+      cell(profile.available[static_cast<std::size_t>(PerfEvent::task_clock)] && totalTime > 0 ? 100.0 * time / static_cast<double>(totalTime) : -1.0, 8);
+      cell(profile.ipc(phase), 8);
+      cell(profile.perIndividual(phase, PerfEvent::cache_misses), 15);
+      cell(profile.perIndividual(phase, PerfEvent::branch_misses), 15);
+      cell(profile.perIndividual(phase, PerfEvent::llc_loads), 12);
+   }
+
+   if(!profile.error.empty())
+      std::cout << "\n\t Some events are unavailable: " << profile.error;
 }
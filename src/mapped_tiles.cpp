@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "mapped_tiles.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GAO_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+#ifdef GAO_HAS_MMAP
+    /// @brief Widens [address, address + bytes) to whole pages, as madvise/msync require.
+    std::pair<void*, std::size_t> pageRange(const void* address, std::size_t bytes)
+    {
+        const std::uintptr_t page{ static_cast<std::uintptr_t>(sysconf(_SC_PAGE_SIZE)) };
+        const std::uintptr_t begin{ reinterpret_cast<std::uintptr_t>(address) & ~(page - 1) };
+        const std::uintptr_t end{ reinterpret_cast<std::uintptr_t>(address) + bytes };
+
+        return { reinterpret_cast<void*>(begin), static_cast<std::size_t>(end - begin) };
+    }
+#endif
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void MappingDeleter::operator()(std::byte* address) const
+{
+#ifdef GAO_HAS_MMAP
+    munmap(address, bytes);
+#else
+    (void)address;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+MappedRegion mapScratchFile(const std::string& directory, std::size_t bytes)
+{
+#ifdef GAO_HAS_MMAP
+    std::string path{ (directory.empty() ? std::string{ "." } : directory) + "/gao_tiles_XXXXXX" };
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+
+    const int fd{ mkstemp(name.data()) };
+    if(fd < 0)
+    {
+        std::cerr << "Unable to create tile file in: " << directory << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // O arquivo some do diretório na hora; o espaço é liberado quando o mapeamento for desfeito
+    unlink(name.data());
+
+    if(ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+        close(fd);
+        std::cerr << "Unable to reserve " << bytes << " bytes for tiles in: " << directory << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    void* address{ mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+    close(fd);
+
+    if(address == MAP_FAILED)
+    {
+        std::cerr << "Unable to map tile file in: " << directory << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return MappedRegion{ static_cast<std::byte*>(address), MappingDeleter{ bytes } };
+#else
+    (void)directory;
+    (void)bytes;
+    return MappedRegion{ nullptr, MappingDeleter{} };
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Asks the kernel to start reading a tile in before it is touched.
+void prefetchRange(const void* address, std::size_t bytes)
+{
+#ifdef GAO_HAS_MMAP
+    const auto [begin, length] { pageRange(address, bytes) };
+    madvise(begin, length, MADV_WILLNEED);
+#else
+    (void)address;
+    (void)bytes;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Starts writeback of a finished tile so its pages can be reclaimed without stalling later.
+void flushRange(const void* address, std::size_t bytes)
+{
+#ifdef GAO_HAS_MMAP
+    const auto [begin, length] { pageRange(address, bytes) };
+    msync(begin, length, MS_ASYNC);
+#else
+    (void)address;
+    (void)bytes;
+#endif
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// File-backed scratch memory for the out-of-core population (POSIX mmap; other platforms fall back to RAM).
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+struct MappingDeleter
+{
+    std::size_t bytes{};
+    void operator()(std::byte* address) const;
+};
+
+using MappedRegion = std::unique_ptr<std::byte, MappingDeleter>;
+
+/// @brief Maps `bytes` of an anonymous (already unlinked) file created in `directory`.
+/// @return an empty region if file mappings are not available
+MappedRegion mapScratchFile(const std::string& directory, std::size_t bytes);
+
+void prefetchRange(const void* address, std::size_t bytes);
+void flushRange(const void* address, std::size_t bytes);
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "migration.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    struct MigrantHeader
+    {
+        std::uint32_t count{};
+        std::uint32_t dimensions{};
+        std::uint32_t geneBytes{};
+    };
+
+    template <typename From, typename T>
+    void readGenes(const std::byte* in, std::vector<T>& genes)
+    {
+        for(std::size_t j {0}; j < genes.size(); ++j)
+        {
+            From value{};
+            std::memcpy(&value, in + j * sizeof(From), sizeof(From));
+            genes[j] = static_cast<T>(value);
+        }
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Packs the first `count` individuals of a (sorted) population.
+template <typename T>
+std::vector<std::byte> serializeMigrants(const Population<T>& population, std::size_t count)
+{
+    count = std::min(count, population.size());
+
+    const MigrantHeader header{ static_cast<std::uint32_t>(count),
+                                static_cast<std::uint32_t>(count ? population[0].size() : 0),
+                                static_cast<std::uint32_t>(sizeof(T)) };
+    const std::size_t recordBytes{ sizeof(double) + header.dimensions * sizeof(T) };
+
+    std::vector<std::byte> payload(sizeof(MigrantHeader) + count * recordBytes);
+    std::memcpy(payload.data(), &header, sizeof(MigrantHeader));
+
+    std::byte* out{ payload.data() + sizeof(MigrantHeader) };
+    for(std::size_t i {0}; i < count; ++i, out += recordBytes)
+    {
+        const double fitness{ population[i].get_fitness() };
+        std::memcpy(out, &fitness, sizeof(double));
+        std::memcpy(out + sizeof(double), population[i].get_genes_array().data(), header.dimensions * sizeof(T));
+    }
+
+    return payload;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Unpacks migrant genes (converted to T). Fitness values are not trusted: receivers re-evaluate.
+template <typename T>
+Population<T> deserializeMigrants(const std::vector<std::byte>& payload, std::size_t dimensions)
+{
+    if(payload.size() < sizeof(MigrantHeader))
+        throw std::invalid_argument("Truncated migrant payload.");
+
+    MigrantHeader header{};
+    std::memcpy(&header, payload.data(), sizeof(MigrantHeader));
+
+    if(header.geneBytes != sizeof(float) && header.geneBytes != sizeof(double))
+        throw std::invalid_argument("Unsupported migrant gene width.");
+
+    // Ilha de outro problema: genomas de outro tamanho quebrariam crossover e avaliação
+    if(header.count > 0 && header.dimensions != dimensions)
+        throw std::invalid_argument("Migrants have " + std::to_string(header.dimensions) + " dimensions, this island has " +
+                                    std::to_string(dimensions) + '.');
+
+    const std::size_t recordBytes{ sizeof(double) + std::size_t{ header.dimensions } * header.geneBytes };
+    if(payload.size() != sizeof(MigrantHeader) + header.count * recordBytes)
+        throw std::invalid_argument("Migrant payload size mismatch.");
+
+    Population<T> migrants;
+    migrants.reserve(header.count);
+
+    const std::byte* in{ payload.data() + sizeof(MigrantHeader) };
+    for(std::uint32_t i {0}; i < header.count; ++i, in += recordBytes)
+    {
+        std::vector<T> genes(header.dimensions);
+
+        if(header.geneBytes == sizeof(double))
+            readGenes<double>(in + sizeof(double), genes);
+        else
+            readGenes<float>(in + sizeof(double), genes);
+
+        migrants.emplace_back(std::move(genes));
+    }
+
+    return migrants;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+std::size_t migrantPayloadLimit(std::size_t count, std::size_t dimensions)
+{
+    return sizeof(MigrantHeader) + count * (sizeof(double) + dimensions * sizeof(double));
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template std::vector<std::byte> serializeMigrants<float>(const Population<float>&, std::size_t);
+template std::vector<std::byte> serializeMigrants<double>(const Population<double>&, std::size_t);
+template Population<float> deserializeMigrants<float>(const std::vector<std::byte>&, std::size_t);
+template Population<double> deserializeMigrants<double>(const std::vector<std::byte>&, std::size_t);
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "Chromosome.h"
+
+// Compact migrant records exchanged between islands: a header (count, dimensions, bytes per gene)
+// followed by `count` records of fitness (f64) + raw genes. Gene width travels with the payload, so
+// float and double islands can trade migrants. Byte order is the host's (all supported targets are little-endian).
+
+template <typename T>
+std::vector<std::byte> serializeMigrants(const Population<T>& population, std::size_t count);
+/// @brief Throws std::invalid_argument for a malformed payload or genomes that are not `dimensions` long.
+template <typename T>
+Population<T> deserializeMigrants(const std::vector<std::byte>& payload, std::size_t dimensions);
+
+/// @brief Largest payload a record of `count` migrants of `dimensions` genes can take (double genes).
+std::size_t migrantPayloadLimit(std::size_t count, std::size_t dimensions);
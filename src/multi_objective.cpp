@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <omp.h>
+#include "multi_objective.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    /// @brief True if row `a` dominates row `b`, knowing that `a` does not come after `b` lexicographically.
+    bool dominatesSorted(const double* a, const double* b, std::size_t m)
+    {
+        bool strictly{ a[0] < b[0] };
+
+        for(std::size_t j {1}; j < m; ++j)
+        {
+            if(a[j] > b[j])
+                return false;
+            strictly = strictly || a[j] < b[j];
+        }
+
+        return strictly;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+std::size_t objectiveCount(const Parameters& p)
+{
+    if(p.objective_function == ObjectiveFunction::dtlz2)
+        return static_cast<std::size_t>(p.objectives > 1 ? p.objectives : 3);
+
+    return 2;
+}
+
+SearchBounds objectiveBounds(const Parameters& p)
+{
+    const std::size_t n{ std::max<std::size_t>(static_cast<std::size_t>(std::max(p.dimensions, 2)), objectiveCount(p)) };
+    return SearchBounds{ std::vector<double>(n, 0.0), std::vector<double>(n, 1.0), p.boundary_handling };
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void evaluateObjectives(ObjectiveFunction fnc, const double* x, std::size_t n, double* out, std::size_t m)
+{
+    using Constants::Math::pi;
+
+    if(fnc == ObjectiveFunction::dtlz2)
+    {
+        double g{ 0.0 };
+        for(std::size_t i {m - 1}; i < n; ++i)
+            g += (x[i] - 0.5) * (x[i] - 0.5);
+
+        for(std::size_t k {0}; k < m; ++k)
+        {
+            double f{ 1.0 + g };
+            for(std::size_t i {0}; i + k + 1 < m; ++i)
+                f *= std::cos(0.5 * pi * x[i]);
+            if(k > 0)
+                f *= std::sin(0.5 * pi * x[m - 1 - k]);
+
+            out[k] = f;
+        }
+        return;
+    }
+
+    // ZDT: f1 = x0, f2 = g * h(f1, g)
+    double sum{ 0.0 };
+    for(std::size_t i {1}; i < n; ++i)
+        sum += x[i];
+
+    const double f1{ x[0] };
+    const double g{ 1.0 + 9.0 * sum / static_cast<double>(n - 1) };
+    const double r{ f1 / g };
+
+    double h{};
+    switch(fnc)
+    {
+        case ObjectiveFunction::zdt2: h = 1.0 - r * r;                                       break;
+        case ObjectiveFunction::zdt3: h = 1.0 - std::sqrt(r) - r * std::sin(10.0 * pi * f1); break;
+        default:                      h = 1.0 - std::sqrt(r);                                break;
+    }
+
+    out[0] = f1;
+    out[1] = g * h;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+std::vector<std::vector<int>> nonDominatedSort(const double* objectives, std::size_t n, std::size_t m, std::vector<int>& rank)
+{
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+
+    std::sort(order.begin(), order.end(), [objectives, m](int a, int b)
+    {
+        return std::lexicographical_compare(objectives + a * m, objectives + (a + 1) * m, objectives + b * m, objectives + (b + 1) * m);
+    });
+
+    std::vector<std::vector<int>> fronts{};
+    rank.assign(n, 0);
+
+    for(int idx : order)
+    {
+        const double* candidate{ objectives + idx * m };
+
+        auto dominatedBy{ [&](const std::vector<int>& front)
+        {
+            for(auto it {front.rbegin()}; it != front.rend(); ++it)
+            {
+                if(dominatesSorted(objectives + *it * m, candidate, m))
+                    return true;
+            }
+            return false;
+        } };
+
+        // Se alguém da frente k domina o candidato, alguém de cada frente anterior também domina
+        std::size_t low{ 0 }, high{ fronts.size() };
+        while(low < high)
+        {
+            const std::size_t mid{ (low + high) / 2 };
+            if(dominatedBy(fronts[mid]))
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        if(low == fronts.size())
+            fronts.emplace_back();
+
+        fronts[low].push_back(idx);
+        rank[idx] = static_cast<int>(low);
+    }
+
+    return fronts;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void crowdingDistance(const double* objectives, std::size_t m, std::span<const int> front, std::vector<double>& distance, int numThreads)
+{
+    constexpr std::size_t minParallelFront{ 512 };
+    const std::size_t size{ front.size() };
+
+    if(size <= 2)
+    {
+        for(int idx : front)
+            distance[idx] = std::numeric_limits<double>::infinity();
+        return;
+    }
+
+    // Uma coluna de distâncias parciais por objetivo, somadas no fim
+    std::vector<double> partial(m * size, 0.0);
+
+    #pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1 && size >= minParallelFront && m > 1)
+    for(std::size_t j = 0; j < m; ++j)
+    {
+        std::vector<int> positions(size);
+        std::iota(positions.begin(), positions.end(), 0);
+        std::sort(positions.begin(), positions.end(), [&](int a, int b) { return objectives[front[a] * m + j] < objectives[front[b] * m + j]; });
+
+        const double low{ objectives[front[positions.front()] * m + j] };
+        const double range{ objectives[front[positions.back()] * m + j] - low };
+        double* column{ partial.data() + j * size };
+
+        column[positions.front()] = column[positions.back()] = std::numeric_limits<double>::infinity();
+
+        if(range <= 0.0)
+            continue;
+
+        for(std::size_t k {1}; k + 1 < size; ++k)
+            column[positions[k]] += (objectives[front[positions[k + 1]] * m + j] - objectives[front[positions[k - 1]] * m + j]) / range;
+    }
+
+    for(std::size_t k {0}; k < size; ++k)
+    {
+        double sum{ 0.0 };
+        for(std::size_t j {0}; j < m; ++j)
+            sum += partial[j * size + k];
+        distance[front[k]] = sum;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void writeParetoFronts(const std::string& path, const std::vector<RunResult>& results)
+{
+    std::ofstream file{ path };
+    if(!file.is_open())
+    {
+        std::cerr << "Unable to open Pareto front file: " << path << std::endl;
+        return;
+    }
+
+    const ParetoFront* shape{ results.empty() ? nullptr : &results.front().pareto };
+
+    file << "test";
+    for(std::size_t j {0}; shape && j < shape->objectives; ++j)
+        file << ",f" << j;
+    for(std::size_t j {0}; shape && j < shape->dimensions; ++j)
+        file << ",x" << j;
+    file << '\n';
+
+    file.precision(std::numeric_limits<double>::max_digits10);
+
+    for(std::size_t test {0}; test < results.size(); ++test)
+    {
+        const ParetoFront& front{ results[test].pareto };
+
+        for(std::size_t i {0}; i < front.size(); ++i)
+        {
+            file << test;
+            for(std::size_t j {0}; j < front.objectives; ++j)
+                file << ',' << front.values[i * front.objectives + j];
+            for(std::size_t j {0}; j < front.dimensions; ++j)
+                file << ',' << front.genes[i * front.dimensions + j];
+            file << '\n';
+        }
+    }
+}
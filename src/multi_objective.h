@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+#include "Parameters.h"
+#include "RunResult.h"
+#include "SearchBounds.h"
+
+// Building blocks of the multi-objective engine (engine=nsga2). Objective vectors are stored in flat
+// row-major arrays, one row of `m` values per individual; every objective is minimized.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Number of objectives of p.objective_function (ZDT: 2, DTLZ2: `objectives`, default 3).
+std::size_t  objectiveCount(const Parameters& p);
+
+/// @brief Unit box of the test problems, in p.dimensions dimensions (at least objectiveCount for DTLZ2).
+SearchBounds objectiveBounds(const Parameters& p);
+
+void         evaluateObjectives(ObjectiveFunction fnc, const double* x, std::size_t n, double* out, std::size_t m);
+
+/// @brief Efficient non-dominated sort with binary search over the fronts (ENS-BS).
+///
+/// Individuals are visited in lexicographic order, so a solution can only be dominated by ones already
+/// placed; its front is found by binary search, and each front is checked from its last member back.
+/// @param rank  filled with the front index (0 = non-dominated) of every individual
+/// @return the fronts, each listing individual indices
+std::vector<std::vector<int>> nonDominatedSort(const double* objectives, std::size_t n, std::size_t m, std::vector<int>& rank);
+
+/// @brief NSGA-II crowding distance of the members of `front`, written to distance[index].
+///
+/// The per-objective sorts run in parallel for large fronts.
+void         crowdingDistance(const double* objectives, std::size_t m, std::span<const int> front, std::vector<double>& distance, int numThreads);
+
+/// @brief CSV of every run's Pareto front: test, f0..f(m-1), x0..x(n-1).
+void         writeParetoFronts(const std::string& path, const std::vector<RunResult>& results);
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <omp.h>
+#include "niching.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    // Profundidade até onde os subárvores viram tarefas paralelas
+    constexpr int taskLevels{ 6 };
+
+    // Teto da contagem de vizinhos do fitness sharing: com a população concentrada num só nicho o custo
+    // continuaria quadrático, e acima disso a penalidade já domina a seleção
+    constexpr int sharingNeighbors{ 256 };
+
+    // Pontos examinados por consulta; limita o custo a O(N) por geração quando a árvore não consegue podar
+    constexpr std::size_t queryBudget{ 1024 };
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void KdTree::build(std::span<const double> points, std::size_t count, std::size_t dimensions, int numThreads)
+{
+    m_points     = points;
+    m_dimensions = dimensions;
+
+    m_order.resize(count);
+    std::iota(m_order.begin(), m_order.end(), std::uint32_t{ 0 });
+
+    // Árvore balanceada: folhas na profundidade em que a maior faixa cabe em leafSize
+    std::size_t levels{ 1 };
+    for(std::size_t size {count}; size > leafSize; size = (size + 1) / 2)
+        ++levels;
+    m_nodes.assign((std::size_t{ 1 } << levels) - 1, Node{});
+    m_boxes.resize(m_nodes.size() * 2 * dimensions);
+
+    #pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+    #pragma omp single
+    buildNode(0, 0, static_cast<std::uint32_t>(count), numThreads > 1 ? taskLevels : 0);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void KdTree::buildNode(std::size_t node, std::uint32_t begin, std::uint32_t end, int taskDepth)
+{
+    Node& current{ m_nodes[node] };
+    current.begin = begin;
+    current.end   = end;
+
+    double* low{ m_boxes.data() + 2 * node * m_dimensions };
+    double* high{ low + m_dimensions };
+    std::fill(low, high, std::numeric_limits<double>::max());
+    std::fill(high, high + m_dimensions, std::numeric_limits<double>::lowest());
+
+    for(std::uint32_t k {begin}; k < end; ++k)
+    {
+        const double* point{ m_points.data() + std::size_t{ m_order[k] } * m_dimensions };
+        for(std::size_t d {0}; d < m_dimensions; ++d)
+        {
+            low[d]  = std::min(low[d], point[d]);
+            high[d] = std::max(high[d], point[d]);
+        }
+    }
+
+    if(end - begin <= leafSize)
+        return;
+
+    // Corta na mediana da coordenada de maior amplitude dentro da faixa
+    std::size_t dimension{ 0 };
+    for(std::size_t d {1}; d < m_dimensions; ++d)
+        if(high[d] - low[d] > high[dimension] - low[dimension])
+            dimension = d;
+
+    const std::uint32_t middle{ begin + (end - begin) / 2 };
+    std::nth_element(m_order.begin() + begin, m_order.begin() + middle, m_order.begin() + end,
+                     [this, dimension](std::uint32_t a, std::uint32_t b) { return m_points[a * m_dimensions + dimension] < m_points[b * m_dimensions + dimension]; });
+
+    current.leaf      = false;
+    current.dimension = static_cast<std::uint32_t>(dimension);
+    current.split     = m_points[m_order[middle] * m_dimensions + dimension];
+
+    // Tudo à esquerda de middle é <= split e tudo a partir dele é >= split
+    if(taskDepth > 0)
+    {
+        #pragma omp task
+        buildNode(2 * node + 1, begin, middle, taskDepth - 1);
+        buildNode(2 * node + 2, middle, end, taskDepth - 1);
+        #pragma omp taskwait
+    }
+    else
+    {
+        buildNode(2 * node + 1, begin, middle, 0);
+        buildNode(2 * node + 2, middle, end, 0);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+double nicheRadius(const Parameters& p)
+{
+    return p.niche_radius > 0.0 ? p.niche_radius : 0.1;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void applyNiching(const Population<T>& population, const Parameters& p, const SearchBounds& bounds, std::vector<double>& fitness, int numThreads)
+{
+    const std::size_t count{ population.size() };
+    const std::size_t dimensions{ bounds.size() };
+    const double radius{ nicheRadius(p) };
+
+    if(count < 2)
+        return;
+
+    // Genes escalados para a caixa unitária, uma linha por indivíduo. Buffers da thread chamadora, acessados
+    // por referência: dentro da região paralela o nome thread_local apontaria para a cópia de cada worker
+    thread_local std::vector<double> pointsBuffer{};
+    thread_local KdTree treeBuffer{};
+    std::vector<double>& points{ pointsBuffer };
+    KdTree& tree{ treeBuffer };
+    points.resize(count * dimensions);
+
+    #pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1)
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const std::span<const T> genes{ population[i].genes() };
+        for(std::size_t j {0}; j < dimensions; ++j)
+            points[i * dimensions + j] = std::clamp((static_cast<double>(genes[j]) - bounds.lower(j)) / (bounds.upper(j) - bounds.lower(j)), 0.0, 1.0);
+    }
+
+    tree.build(points, count, dimensions, numThreads);
+
+    if(p.niching == Niching::sharing)
+    {
+        // Minimização: a aptidão bruta é a distância até o pior, dividida pelo número de vizinhos do nicho
+        const double worst{ fitness[count - 1] };
+        const double offset{ 1e-12 * std::max(1.0, std::abs(worst - fitness[0])) };
+        thread_local std::vector<double> sharedBuffer{};
+        std::vector<double>& shared{ sharedBuffer };
+        shared.resize(count);
+
+        #pragma omp parallel for schedule(dynamic, 64) num_threads(numThreads) if(numThreads > 1)
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            double niche{ 1.0 };
+            int neighbors{ 0 };
+            tree.forNeighbors(i, radius, [&](std::size_t, double distance2) {
+                niche += 1.0 - std::sqrt(distance2) / radius;
+                return ++neighbors < sharingNeighbors;
+            }, queryBudget);
+
+            shared[i] = -(worst - fitness[i] + offset) / niche;
+        }
+
+        fitness.swap(shared);
+        return;
+    }
+
+    // Clearing: percorre do melhor para o pior; cada vencedor mantém `capacity` indivíduos no seu nicho e zera o resto
+    const int capacity{ std::max(1, p.niche_capacity) };
+    thread_local std::vector<char> cleared{};
+    thread_local std::vector<std::size_t> niche{};
+    cleared.assign(count, 0);
+
+    for(std::size_t i {0}; i < count; ++i)
+    {
+        if(cleared[i])
+            continue;
+
+        niche.clear();
+        tree.forNeighbors(i, radius, [&](std::size_t j, double) {
+            if(j > i && !cleared[j])
+                niche.push_back(j);
+            return true;
+        }, queryBudget);
+
+        // Índices menores são melhores: os capacity - 1 primeiros vizinhos ficam
+        std::sort(niche.begin(), niche.end());
+        for(std::size_t k {static_cast<std::size_t>(capacity - 1)}; k < niche.size(); ++k)
+            cleared[niche[k]] = 1;
+    }
+
+    for(std::size_t i {0}; i < count; ++i)
+        if(cleared[i])
+            fitness[i] = std::numeric_limits<double>::max();
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template void applyNiching<float>(const Population<float>&, const Parameters&, const SearchBounds&, std::vector<double>&, int);
+template void applyNiching<double>(const Population<double>&, const Parameters&, const SearchBounds&, std::vector<double>&, int);
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Chromosome.h"
+#include "Parameters.h"
+#include "SearchBounds.h"
+
+// Niching for multimodal landscapes (`niching` key). Fitness sharing and clearing rewrite the fitness array
+// parent selection reads (tournament, fps and ranking), so crowded basins lose selection pressure; deterministic crowding (in breedRange)
+// makes each child compete only with its closest parent. Distances are measured in the domain scaled to the
+// unit box, and neighbour queries go through a k-d tree instead of comparing every pair.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief k-d tree over the population, rebuilt every generation, for fixed-radius neighbour queries.
+///
+/// Nodes split their range at the median of the coordinate with the largest spread, so the tree is balanced
+/// and lives in a heap-ordered array; subtrees are built as parallel tasks. Every node keeps the bounding box
+/// of its points, and a query skips any node whose box is farther than the radius over all coordinates
+/// (a split plane alone prunes almost nothing once there are more than a handful of dimensions).
+///
+/// When the radius is close to the spread of the population in many dimensions almost every box still
+/// reaches the ball, so queries take an optional budget of examined points. The child on the point's side
+/// of each split is searched first, which makes a budgeted query see the closest part of the population.
+class KdTree
+{
+public:
+    static constexpr std::size_t leafSize{ 16 };
+
+    /// @param points `count` row-major points of `dimensions` coordinates, kept by reference
+    void build(std::span<const double> points, std::size_t count, std::size_t dimensions, int numThreads);
+
+    /// @brief Calls visit(j, squaredDistance) for every point j != i closer than `radius`; a false return stops the query.
+    /// @param budget points and node boxes examined before the query gives up
+    template <typename Visit>
+    void forNeighbors(std::size_t i, double radius, Visit&& visit, std::size_t budget = std::numeric_limits<std::size_t>::max()) const;
+
+private:
+    struct Node
+    {
+        std::uint32_t begin{};
+        std::uint32_t end{};
+        std::uint32_t dimension{};
+        bool          leaf{ true };
+        double        split{};
+    };
+
+    void buildNode(std::size_t node, std::uint32_t begin, std::uint32_t end, int taskDepth);
+
+    std::span<const double>    m_points{};
+    std::size_t                m_dimensions{};
+    std::vector<std::uint32_t> m_order{};   // índices dos pontos, particionados pelos nós
+    std::vector<Node>          m_nodes{};   // filhos de k em 2k + 1 e 2k + 2
+    std::vector<double>        m_boxes{};   // por nó: dimensions mínimos seguidos de dimensions máximos
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Niche radius in the unit box: niche_radius, or 0.1 when unset.
+double nicheRadius(const Parameters& p);
+
+/// @brief Applies fitness sharing or clearing to the selection fitness of a population sorted best first.
+///
+/// Lower stays better: shared values are negated and cleared individuals get the largest double.
+template <typename T>
+void applyNiching(const Population<T>& population, const Parameters& p, const SearchBounds& bounds, std::vector<double>& fitness, int numThreads);
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename Visit>
+void KdTree::forNeighbors(std::size_t i, double radius, Visit&& visit, std::size_t budget) const
+{
+    if(m_nodes.empty())
+        return;
+
+    const double* point{ m_points.data() + i * m_dimensions };
+    const double radius2{ radius * radius };
+
+    std::size_t stack[64]{};
+    std::size_t top{ 0 };
+    stack[top++] = 0;
+
+    while(top > 0)
+    {
+        const std::size_t index{ stack[--top] };
+        const Node& node{ m_nodes[index] };
+
+        // Cada caixa testada conta como um ponto examinado
+        if(budget == 0)
+            return;
+        --budget;
+
+        // Distância do ponto até a caixa do nó
+        const double* low{ m_boxes.data() + 2 * index * m_dimensions };
+        const double* high{ low + m_dimensions };
+        double gap{ 0.0 };
+        for(std::size_t d {0}; d < m_dimensions && gap < radius2; ++d)
+        {
+            const double outside{ std::max({ low[d] - point[d], point[d] - high[d], 0.0 }) };
+            gap += outside * outside;
+        }
+
+        if(gap >= radius2)
+            continue;
+
+        if(!node.leaf)
+        {
+            // O lado do ponto sai da pilha primeiro
+            const bool left{ point[node.dimension] < node.split };
+            stack[top++] = left ? 2 * index + 2 : 2 * index + 1;
+            stack[top++] = left ? 2 * index + 1 : 2 * index + 2;
+            continue;
+        }
+
+        if(budget < node.end - node.begin)
+            return;
+        budget -= node.end - node.begin;
+
+        for(std::uint32_t k {node.begin}; k < node.end; ++k)
+        {
+            const std::size_t j{ m_order[k] };
+            if(j == i)
+                continue;
+
+            const double* other{ m_points.data() + j * m_dimensions };
+            double sum{ 0.0 };
+            for(std::size_t d {0}; d < m_dimensions && sum < radius2; ++d)
+            {
+                const double diff{ point[d] - other[d] };
+                sum += diff * diff;
+            }
+
+            if(sum < radius2 && !visit(j, sum))
+                return;
+        }
+    }
+}
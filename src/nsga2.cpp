@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <omp.h>
+#include "crossover.h"
+#include "engines.h"
+#include "genetic_operators.h"
+#include "multi_objective.h"
+#include "MutationSchedule.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    /// @brief Parents, offspring and their objectives in flat row-major arrays of 2N rows: [0, N) parents, [N, 2N) offspring.
+    struct Combined
+    {
+        std::vector<double> genes{};
+        std::vector<double> objectives{};
+        std::vector<int>    rank{};
+        std::vector<double> crowding{};
+
+        void resize(std::size_t rows, std::size_t n, std::size_t m)
+        {
+            genes.resize(rows * n);
+            objectives.resize(rows * m);
+            rank.resize(rows);
+            crowding.resize(rows);
+        }
+    };
+
+    /// @brief Binary tournament on (front, crowding distance).
+    int crowdedTournament(const Combined& pop, int size)
+    {
+        const int a{ Random::uniform(0, size) };
+        const int b{ Random::uniform(0, size) };
+
+        if(pop.rank[a] != pop.rank[b])
+            return pop.rank[a] < pop.rank[b] ? a : b;
+
+        return pop.crowding[a] >= pop.crowding[b] ? a : b;
+    }
+
+    void evaluateRows(Combined& pop, int begin, int end, ObjectiveFunction fnc, std::size_t n, std::size_t m, int numThreads, bool parallel)
+    {
+        #pragma omp parallel for schedule(static) num_threads(numThreads) if(parallel)
+        for(int i = begin; i < end; ++i)
+            evaluateObjectives(fnc, pop.genes.data() + i * n, n, pop.objectives.data() + i * m, m);
+    }
+
+    /// @brief Ranks and crowding of rows [0, rows); returns the fronts.
+    std::vector<std::vector<int>> rankRows(Combined& pop, std::size_t rows, std::size_t m, int numThreads)
+    {
+        std::vector<std::vector<int>> fronts{ nonDominatedSort(pop.objectives.data(), rows, m, pop.rank) };
+
+        for(const std::vector<int>& front : fronts)
+            crowdingDistance(pop.objectives.data(), m, front, pop.crowding, numThreads);
+
+        return fronts;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief NSGA-II: elitist multi-objective GA with non-dominated sorting and crowding-distance survival.
+///
+/// The GA's crossover kernels, mutation schedule and boundary handling are reused on flat gene rows.
+RunResult nsga2(const Parameters& p, int numThreads, bool parallel)
+{
+    if(p.pop_size < 4)
+        throw std::invalid_argument("NSGA-II needs pop_size >= 4.");
+
+    const SearchBounds bounds{ objectiveBounds(p) };
+    const std::size_t n{ bounds.size() };
+    const std::size_t m{ objectiveCount(p) };
+    const int N{ p.pop_size + (p.pop_size & 1) };   // pares completos de filhos
+    const int threads{ parallel ? numThreads : 1 };
+
+    const CrossoverSettings settings{ CrossoverSettings::from(p, bounds) };
+    RunState state{};
+
+    Combined pop{}, next{};
+    pop.resize(2 * N, n, m);
+    next.resize(2 * N, n, m);
+
+    const Population<double> initial{ initialization<double>(bounds, N, p.init_sampling, threads) };
+    for(int i {0}; i < N; ++i)
+        std::copy(initial[i].get_genes_array().begin(), initial[i].get_genes_array().end(), pop.genes.begin() + i * n);
+
+    evaluateRows(pop, 0, N, p.objective_function, n, m, numThreads, parallel);
+    rankRows(pop, N, m, threads);
+
+    std::vector<int> survivors{};
+    survivors.reserve(N);
+
+    for(int generation {0}; generation < p.nIterations; ++generation)
+    {
+        state.generation = generation;
+        updateMutationSchedule(p, state);
+
+        // Filhos nas linhas [N, 2N)
+        for(int k {N}; k < 2 * N; k += 2)
+        {
+            const int a{ crowdedTournament(pop, N) };
+            const int b{ crowdedTournament(pop, N) };
+
+            double* child1{ pop.genes.data() + k * n };
+            double* child2{ pop.genes.data() + (k + 1) * n };
+            crossoverPair(pop.genes.data() + a * n, pop.genes.data() + b * n, child1, child2, n, p.points, settings);
+
+            for(double* child : { child1, child2 })
+            {
+                std::normal_distribution<double> gauss(0.0, state.mutation_strength);
+                for(std::size_t j {0}; j < n; ++j)
+                {
+                    if(Random::rand() < state.mutation_rate)
+                        child[j] += gauss(Random::mt);
+                }
+                bounds.repair(child, n);
+            }
+        }
+
+        evaluateRows(pop, N, 2 * N, p.objective_function, n, m, numThreads, parallel);
+
+        // Sobrevivência: frentes inteiras enquanto couberem, a última cortada pela distância de aglomeração
+        const std::vector<std::vector<int>> fronts{ rankRows(pop, 2 * N, m, threads) };
+
+        survivors.clear();
+        for(const std::vector<int>& front : fronts)
+        {
+            if(survivors.size() + front.size() <= static_cast<std::size_t>(N))
+            {
+                survivors.insert(survivors.end(), front.begin(), front.end());
+                continue;
+            }
+
+            std::vector<int> last{ front };
+            const std::size_t missing{ N - survivors.size() };
+            std::partial_sort(last.begin(), last.begin() + missing, last.end(), [&pop](int a, int b) { return pop.crowding[a] > pop.crowding[b]; });
+            survivors.insert(survivors.end(), last.begin(), last.begin() + missing);
+            break;
+        }
+
+        for(int i {0}; i < N; ++i)
+        {
+            const int from{ survivors[i] };
+            std::copy_n(pop.genes.data() + from * n, n, next.genes.data() + i * n);
+            std::copy_n(pop.objectives.data() + from * m, m, next.objectives.data() + i * m);
+            next.rank[i] = pop.rank[from];
+            next.crowding[i] = pop.crowding[from];
+        }
+
+        std::swap(pop, next);
+
+        if((generation + 1) % 100 == 0 || generation == p.nIterations - 1)
+        {
+            const auto firstFront{ std::count(pop.rank.begin(), pop.rank.begin() + N, 0) };
+            std::cout << "Generation: " << generation + 1 << "\n\tPareto front: " << firstFront << " solutions\n";
+        }
+    }
+
+    // Frente final: os não dominados da população sobrevivente
+    RunResult result{};
+    result.generations = p.nIterations;
+    result.pareto.objectives = m;
+    result.pareto.dimensions = n;
+
+    int bestIndex{ -1 };
+    for(int i {0}; i < N; ++i)
+    {
+        if(pop.rank[i] != 0)
+            continue;
+
+        result.pareto.values.insert(result.pareto.values.end(), pop.objectives.begin() + i * m, pop.objectives.begin() + (i + 1) * m);
+        result.pareto.genes.insert(result.pareto.genes.end(), pop.genes.begin() + i * n, pop.genes.begin() + (i + 1) * n);
+
+        if(bestIndex < 0 || pop.objectives[i * m] < pop.objectives[bestIndex * m])
+            bestIndex = i;
+    }
+
+    // Representante escalar da execução: o extremo da frente com menor primeiro objetivo
+    result.best = Chromosome(std::vector<double>(pop.genes.begin() + bestIndex * n, pop.genes.begin() + (bestIndex + 1) * n));
+    result.best.set_fitness(pop.objectives[bestIndex * m]);
+
+    return result;
+}
@@ -0,0 +1,53 @@
+#include "engines.h"
+#include "local_search.h"
+#include "SearchBounds.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Runs one test with the engine and GA variant the parameters select.
+///
+/// The GA goes to fixedGenomeGA for the dimensions with a compiled genome, to largePopulationGA for
+/// `large_population` and to geneticAlgorithm otherwise; `float`/`mixed` precision run in float, and
+/// `mixed` then polishes the best individual in double.
+RunResult runOptimizer(const Parameters& p, int numThreads, bool parallel, IslandLink* island)
+{
+    switch(p.engine)
+    {
+        case Engine::de_rand_1_bin:
+        case Engine::de_best_1_bin:
+            return differentialEvolution(p, numThreads, parallel);
+        case Engine::cmaes:
+            return covarianceMatrixAdaptation(p, numThreads, parallel);
+        case Engine::nsga2:
+            return nsga2(p, numThreads, parallel);
+        default:
+            break;
+    }
+
+    // Dimensão pequena e comum: genes em std::array, sem alocação por indivíduo (as ilhas migram Population)
+    const bool fixedGenome{ !island && fixedGenomeApplies(p) };
+
+    if(p.precision == Precision::float64)
+    {
+        if(fixedGenome)
+            return fixedGenomeGA<double>(p, numThreads, parallel);
+
+        return p.large_population ? largePopulationGA<double>(p, numThreads) : geneticAlgorithm<double>(p, numThreads, parallel, island);
+    }
+
+    RunResult result{ p.large_population ? largePopulationGA<float>(p, numThreads)
+                    : fixedGenome        ? fixedGenomeGA<float>(p, numThreads, parallel)
+                                         : geneticAlgorithm<float>(p, numThreads, parallel, island) };
+
+    // Polimento final em double do melhor indivíduo encontrado em float
+    if(p.precision == Precision::mixed)
+    {
+        const SearchBounds bounds{ p.target_function, p.dimensions, p.boundary_handling };
+        const int budget{ p.polish_evaluations > 0 ? p.polish_evaluations : 200 * static_cast<int>(bounds.size()) };
+
+        result.best.evaluate_solution(p.target_function);
+        patternSearch(result.best, p.target_function, bounds, 1e-4, budget);
+    }
+
+    return result;
+}
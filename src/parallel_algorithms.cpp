@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <omp.h>
+#include "parallel_algorithms.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    constexpr std::size_t minParallelSize{ std::size_t{ 1 } << 16 };
+
+    std::size_t blockBegin(std::size_t n, int tid, int threads)
+    {
+        return n * static_cast<std::size_t>(tid) / static_cast<std::size_t>(threads);
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Maps a double to an unsigned key with the same ordering (negatives flipped, positives get the sign bit).
+std::uint64_t fitnessKey(double fitness)
+{
+    const std::uint64_t bits{ std::bit_cast<std::uint64_t>(fitness) };
+    return (bits >> 63) ? ~bits : bits | (std::uint64_t{ 1 } << 63);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+void RadixSorter::sort(const double* fitness, std::size_t n, int numThreads)
+{
+    constexpr int digitBits{ 8 };
+    constexpr std::size_t buckets{ std::size_t{ 1 } << digitBits };
+    constexpr int passes{ 64 / digitBits };
+
+    m_keys.resize(n);
+    m_keysScratch.resize(n);
+    m_order.resize(n);
+    m_orderScratch.resize(n);
+    m_histograms.resize(static_cast<std::size_t>(std::max(1, numThreads)) * buckets);
+
+    bool skipPass{ false };
+
+    #pragma omp parallel num_threads(numThreads) if(n >= minParallelSize)
+    {
+        const int tid{ omp_get_thread_num() };
+        const int threads{ omp_get_num_threads() };
+        const std::size_t begin{ blockBegin(n, tid, threads) };
+        const std::size_t end  { blockBegin(n, tid + 1, threads) };
+
+        for(std::size_t i {begin}; i < end; ++i)
+        {
+            m_keys[i] = fitnessKey(fitness[i]);
+            m_order[i] = static_cast<std::uint32_t>(i);
+        }
+
+        for(int pass {0}; pass < passes; ++pass)
+        {
+            const int shift{ pass * digitBits };
+            std::size_t* histogram{ m_histograms.data() + static_cast<std::size_t>(tid) * buckets };
+
+            std::fill(histogram, histogram + buckets, 0);
+            for(std::size_t i {begin}; i < end; ++i)
+                ++histogram[(m_keys[i] >> shift) & (buckets - 1)];
+
+            #pragma omp barrier
+
+            // Contagens por (dígito, thread) viram posições iniciais de escrita de cada bloco
+            #pragma omp single
+            {
+                std::size_t offset{ 0 };
+                skipPass = false;
+
+                for(std::size_t digit {0}; digit < buckets; ++digit)
+                {
+                    const std::size_t digitStart{ offset };
+
+                    for(int t {0}; t < threads; ++t)
+                    {
+                        std::size_t& count{ m_histograms[static_cast<std::size_t>(t) * buckets + digit] };
+                        const std::size_t next{ offset + count };
+                        count = offset;
+                        offset = next;
+                    }
+
+                    if(offset - digitStart == n)
+                        skipPass = true;
+                }
+            }
+
+            if(!skipPass)
+            {
+                for(std::size_t i {begin}; i < end; ++i)
+                {
+                    const std::size_t destination{ histogram[(m_keys[i] >> shift) & (buckets - 1)]++ };
+                    m_keysScratch[destination] = m_keys[i];
+                    m_orderScratch[destination] = m_order[i];
+                }
+            }
+
+            #pragma omp barrier
+
+            #pragma omp single
+            {
+                if(!skipPass)
+                {
+                    m_keys.swap(m_keysScratch);
+                    m_order.swap(m_orderScratch);
+                }
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief In-place inclusive prefix sum: every thread scans its block, then adds the sum of the blocks before it.
+/// @return the total
+double parallelPrefixSum(double* values, std::size_t n, int numThreads)
+{
+    if(n == 0)
+        return 0.0;
+
+    std::vector<double> blockSums(static_cast<std::size_t>(std::max(1, numThreads)) + 1, 0.0);
+
+    #pragma omp parallel num_threads(numThreads) if(n >= minParallelSize)
+    {
+        const int tid{ omp_get_thread_num() };
+        const int threads{ omp_get_num_threads() };
+        const std::size_t begin{ blockBegin(n, tid, threads) };
+        const std::size_t end  { blockBegin(n, tid + 1, threads) };
+
+        double sum{ 0.0 };
+        for(std::size_t i {begin}; i < end; ++i)
+        {
+            sum += values[i];
+            values[i] = sum;
+        }
+        blockSums[tid + 1] = sum;
+
+        #pragma omp barrier
+
+        #pragma omp single
+        std::partial_sum(blockSums.begin(), blockSums.begin() + threads + 1, blockSums.begin());
+
+        const double offset{ blockSums[tid] };
+        if(offset != 0.0)
+        {
+            for(std::size_t i {begin}; i < end; ++i)
+                values[i] += offset;
+        }
+    }
+
+    return values[n - 1];
+}
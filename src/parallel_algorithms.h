@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Parallel building blocks of the large-population mode: ranking the fitness array and building selection CDFs.
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Stable LSD radix sort of a fitness array into an index order, with reusable scratch buffers.
+///
+/// Each pass histograms 8 bits of the keys per thread block, turns the histograms into scatter offsets
+/// and scatters every block independently. Passes where all keys share the same digit are skipped.
+class RadixSorter
+{
+public:
+    void                              sort(const double* fitness, std::size_t n, int numThreads);
+    const std::vector<std::uint32_t>& order() const { return m_order; }
+
+    static std::size_t                bytesFor(std::size_t n) { return n * 2 * (sizeof(std::uint64_t) + sizeof(std::uint32_t)); }
+
+private:
+    std::vector<std::uint64_t> m_keys{};
+    std::vector<std::uint64_t> m_keysScratch{};
+    std::vector<std::uint32_t> m_order{};
+    std::vector<std::uint32_t> m_orderScratch{};
+    std::vector<std::size_t>   m_histograms{};
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+std::uint64_t fitnessKey(double fitness);
+double        parallelPrefixSum(double* values, std::size_t n, int numThreads);
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cmath>
+#include "sampling.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    // Primitive polynomials and initial direction numbers for Sobol dimensions 2..21 (Joe & Kuo, new-joe-kuo-6.21201).
+    struct SobolEntry
+    {
+        int s;
+        std::uint32_t a;
+        std::array<std::uint32_t, 7> m;
+    };
+
+    constexpr std::array<SobolEntry, UnitCubeSampler::maxSobolDimensions - 1> sobolTable {{
+        { 1, 0,  { 1 } },
+        { 2, 1,  { 1, 3 } },
+        { 3, 1,  { 1, 3, 1 } },
+        { 3, 2,  { 1, 1, 1 } },
+        { 4, 1,  { 1, 1, 3, 3 } },
+        { 4, 4,  { 1, 3, 5, 13 } },
+        { 5, 2,  { 1, 1, 5, 5, 17 } },
+        { 5, 4,  { 1, 1, 5, 5, 5 } },
+        { 5, 7,  { 1, 1, 7, 11, 19 } },
+        { 5, 11, { 1, 1, 5, 1, 1 } },
+        { 5, 13, { 1, 1, 1, 3, 11 } },
+        { 5, 14, { 1, 3, 5, 5, 31 } },
+        { 6, 1,  { 1, 3, 3, 9, 7, 49 } },
+        { 6, 13, { 1, 1, 1, 15, 21, 21 } },
+        { 6, 16, { 1, 3, 1, 13, 27, 49 } },
+        { 6, 19, { 1, 1, 1, 15, 7, 5 } },
+        { 6, 22, { 1, 3, 1, 15, 13, 25 } },
+        { 6, 25, { 1, 1, 5, 5, 19, 61 } },
+        { 7, 1,  { 1, 3, 7, 11, 23, 15, 103 } },
+        { 7, 4,  { 1, 3, 7, 13, 13, 15, 69 } }
+    }};
+
+    std::uint64_t mix64(std::uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    std::vector<std::uint32_t> firstPrimes(std::size_t count)
+    {
+        std::vector<std::uint32_t> primes;
+        for(std::uint32_t candidate {2}; primes.size() < count; ++candidate)
+        {
+            bool isPrime{ true };
+            for(std::uint32_t prime : primes)
+            {
+                if(prime * prime > candidate)
+                    break;
+                if(candidate % prime == 0)
+                {
+                    isPrime = false;
+                    break;
+                }
+            }
+            if(isPrime)
+                primes.push_back(candidate);
+        }
+        return primes;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+UnitCubeSampler::UnitCubeSampler(InitSampling method, std::size_t dimensions, std::uint64_t numPoints, std::uint64_t seed)
+    : m_method{ method }, m_dimensions{ dimensions }, m_numPoints{ std::max<std::uint64_t>(1, numPoints) }, m_seed{ seed }
+{
+    std::mt19937_64 rng{ seed };
+
+    if(m_method == InitSampling::sobol)
+    {
+        const std::size_t sobolDims{ std::min(dimensions, maxSobolDimensions) };
+        m_directions.resize(sobolDims);
+
+        // Primeira dimensão: sequência de van der Corput
+        for(int k {0}; k < 32; ++k)
+            m_directions[0][k] = 1U << (31 - k);
+
+        for(std::size_t d {1}; d < sobolDims; ++d)
+        {
+            const SobolEntry& entry{ sobolTable[d - 1] };
+            auto& v{ m_directions[d] };
+
+            for(int k {0}; k < entry.s; ++k)
+                v[k] = entry.m[k] << (31 - k);
+
+            for(int k {entry.s}; k < 32; ++k)
+            {
+                v[k] = v[k - entry.s] ^ (v[k - entry.s] >> entry.s);
+                for(int j {1}; j < entry.s; ++j)
+                    v[k] ^= ((entry.a >> (entry.s - 1 - j)) & 1U) * v[k - j];
+            }
+        }
+
+        for(std::size_t d {0}; d < sobolDims; ++d)
+            m_sobolShift.push_back(static_cast<std::uint32_t>(rng()));
+    }
+
+    // Halton também cobre as dimensões além da tabela de Sobol
+    if(m_method == InitSampling::halton || (m_method == InitSampling::sobol && dimensions > maxSobolDimensions))
+    {
+        m_primes = firstPrimes(dimensions);
+        std::uniform_real_distribution<double> shift(0.0, 1.0);
+        for(std::size_t d {0}; d < dimensions; ++d)
+            m_haltonShift.push_back(shift(rng));
+    }
+
+    if(m_method == InitSampling::lhs)
+    {
+        int bits{ 1 };
+        while(bits < 64 && (std::uint64_t{ 1 } << bits) < m_numPoints)
+            ++bits;
+        m_halfBits = (bits + 1) / 2;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Writes the `index`-th point of the set into out[0, dimensions).
+/// @param rng stream used for the random parts (uniform sampling, jitter inside LHS strata)
+void UnitCubeSampler::point(std::uint64_t index, double* out, std::mt19937& rng) const
+{
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    switch(m_method)
+    {
+        case InitSampling::sobol:
+            for(std::size_t d {0}; d < m_dimensions; ++d)
+                out[d] = d < maxSobolDimensions ? sobol(index, d) : halton(index, d);
+            break;
+
+        case InitSampling::halton:
+            for(std::size_t d {0}; d < m_dimensions; ++d)
+                out[d] = halton(index, d);
+            break;
+
+        case InitSampling::lhs:
+            for(std::size_t d {0}; d < m_dimensions; ++d)
+                out[d] = (static_cast<double>(permute(index % m_numPoints, d)) + unit(rng)) / static_cast<double>(m_numPoints);
+            break;
+
+        default:
+            for(std::size_t d {0}; d < m_dimensions; ++d)
+                out[d] = unit(rng);
+            break;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Sobol coordinate computed directly from the Gray code of the index, with a random digital shift.
+double UnitCubeSampler::sobol(std::uint64_t index, std::size_t dim) const
+{
+    std::uint64_t gray{ index ^ (index >> 1) };
+    std::uint32_t x{ 0 };
+
+    for(int k {0}; gray != 0 && k < 32; ++k, gray >>= 1)
+    {
+        if(gray & 1U)
+            x ^= m_directions[dim][k];
+    }
+
+    x ^= m_sobolShift[dim];
+
+    return static_cast<double>(x) * 0x1.0p-32;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Radical inverse of index + 1 in the dimension's prime base, rotated by a random shift.
+double UnitCubeSampler::halton(std::uint64_t index, std::size_t dim) const
+{
+    const std::uint32_t base{ m_primes[dim] };
+    const double invBase{ 1.0 / base };
+
+    double value{ 0.0 };
+    double factor{ invBase };
+
+    for(std::uint64_t i {index + 1}; i > 0; i /= base)
+    {
+        value += static_cast<double>(i % base) * factor;
+        factor *= invBase;
+    }
+
+    value += m_haltonShift[dim];
+    return value >= 1.0 ? value - 1.0 : value;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Keyed pseudo-random permutation of [0, numPoints): a 4-round Feistel network with cycle walking.
+std::uint64_t UnitCubeSampler::permute(std::uint64_t index, std::size_t dim) const
+{
+    const std::uint64_t mask{ (std::uint64_t{ 1 } << m_halfBits) - 1 };
+    const std::uint64_t key{ mix64(m_seed ^ mix64(dim + 1)) };
+
+    do
+    {
+        std::uint64_t left{ index >> m_halfBits };
+        std::uint64_t right{ index & mask };
+
+        for(std::uint64_t round {0}; round < 4; ++round)
+        {
+            const std::uint64_t next{ left ^ (mix64(right ^ key ^ (round << 56)) & mask) };
+            left = right;
+            right = next;
+        }
+
+        index = (left << m_halfBits) | right;
+    }
+    while(index >= m_numPoints);
+
+    return index;
+}
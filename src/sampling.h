@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "constants.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+/// @brief Point sets over the unit cube [0, 1)^d used to seed the initial population.
+///
+/// Every method is addressable by point index, so chunks of the population can be filled
+/// independently and in parallel. Sobol and Halton get a random shift per run; the Latin
+/// hypercube uses keyed pseudo-random permutations instead of storing one per dimension.
+class UnitCubeSampler
+{
+public:
+    UnitCubeSampler(InitSampling method, std::size_t dimensions, std::uint64_t numPoints, std::uint64_t seed);
+
+    void point(std::uint64_t index, double* out, std::mt19937& rng) const;
+
+    static constexpr std::size_t maxSobolDimensions{ 21 };
+
+private:
+    double sobol(std::uint64_t index, std::size_t dim) const;
+    double halton(std::uint64_t index, std::size_t dim) const;
+    std::uint64_t permute(std::uint64_t index, std::size_t dim) const;
+
+    InitSampling                              m_method;
+    std::size_t                               m_dimensions;
+    std::uint64_t                             m_numPoints;
+    std::uint64_t                             m_seed;
+    std::vector<std::array<std::uint32_t, 32>> m_directions{};   // Sobol: números de direção por dimensão
+    std::vector<std::uint32_t>                m_sobolShift{};
+    std::vector<std::uint32_t>                m_primes{};         // Halton: base por dimensão
+    std::vector<double>                       m_haltonShift{};
+    int                                       m_halfBits{};       // LHS: metade dos bits do domínio da permutação
+};
@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "engines.h"
+#include "Random.h"
+#include "Timer.h"
+
+// Performance regression suite, registered with ctest one scenario per test. A scenario is one
+// TargetFunction x SelectionMethod x Points combination of the GA, run on one thread with a fixed seed.
+//
+// The GA goes through runOptimizer, so each scenario times the variant production runs for it (the
+// fixed-genome GA for the 2D and 10D scenarios). A scenario is rerun for at least `measureSeconds` of
+// wall time and the median rate over those runs is compared with tests/perf_baseline.json: generations
+// and evaluations per second may not fall below (1 - band) of the stored medians, where the band is the
+// tolerance widened to twice the run-to-run spread recorded with the baseline. The runs also have to
+// agree with each other (same seed, same result) and the best fitness may never get worse from one
+// generation to the next (elitism).
+//
+//   gao_perf <baseline.json> <function> <selection> <points>   one scenario
+//   gao_perf <baseline.json> --all                             every scenario
+//   gao_perf <baseline.json> --update                          measures every scenario and rewrites the baseline
+//
+// GAO_PERF_TOLERANCE overrides the tolerance stored in the baseline (e.g. on a loaded CI machine).
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    constexpr std::uint64_t seed{ 20240917 };
+    constexpr int           minimumRuns{ 5 };
+    constexpr double        measureSeconds{ 1.0 };
+    constexpr double        defaultTolerance{ 0.5 };
+
+    // Na ordem dos enums TargetFunction, SelectionMethod e Points
+    constexpr std::array<std::string_view, 9> functions{ "rastrigin", "ackley", "sphere", "easom", "mccormick", "rosenbrock", "schwefel", "griewank", "levy" };
+    constexpr std::array<std::string_view, 3> selections{ "tournament", "fps", "ranking" };
+    constexpr std::array<std::string_view, 6> crossovers{ "one", "two", "uniform", "arithmetic", "blx", "sbx" };
+
+    struct Scenario
+    {
+        std::size_t function{};
+        std::size_t selection{};
+        std::size_t points{};
+
+        std::string name() const
+        {
+            return std::string{ functions[function] } + '/' + std::string{ selections[selection] } + '/' + std::string{ crossovers[points] };
+        }
+    };
+
+    template <std::size_t N>
+    bool indexOf(const std::array<std::string_view, N>& names, std::string_view name, std::size_t& index)
+    {
+        index = static_cast<std::size_t>(std::find(names.begin(), names.end(), name) - names.begin());
+        return index < N;
+    }
+
+    struct Measurement
+    {
+        double              generationsPerSecond{};
+        double              evaluationsPerSecond{};
+        double              spread{};               // 1 - (10th percentile / median) of generations/s
+        int                 runs{};
+        double              bestFitness{};
+        std::vector<std::string> failures{};
+    };
+
+    struct Baseline
+    {
+        double generationsPerSecond{};
+        double evaluationsPerSecond{};
+        double spread{};
+        bool   found{};
+    };
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    Parameters scenarioParameters(const Scenario& scenario)
+    {
+        Parameters p{};
+        p.target_function           = static_cast<TargetFunction>(scenario.function);
+        p.method                    = static_cast<SelectionMethod>(scenario.selection);
+        p.points                    = static_cast<Points>(scenario.points);
+
+        // Funções de duas variáveis ficam em 2D; as demais em 10D
+        p.dimensions                = (p.target_function == TargetFunction::easom || p.target_function == TargetFunction::mccormick) ? 2 : 10;
+        p.nIterations               = 150;
+        p.pop_size                  = 200;
+        p.initial_mutation_rate     = 0.2;
+        p.final_mutation_rate       = 0.1;
+        p.initial_mutation_strength = 0.2;
+        p.final_mutation_strength   = 0.001;
+        p.elite_fraction            = 0.02;
+        p.num_tests                 = 1;
+        p.threads_per_test          = 1;
+        p.trace_length              = p.nIterations;
+        p.seed                      = seed;
+
+        return p;
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    double quantile(std::vector<double> values, double q)
+    {
+        const std::size_t k{ static_cast<std::size_t>(q * static_cast<double>(values.size() - 1)) };
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(k), values.end());
+        return values[k];
+    }
+
+    Measurement measure(const Scenario& scenario)
+    {
+        const Parameters p{ scenarioParameters(scenario) };
+        Measurement measurement{};
+        std::vector<double> bests{};
+        std::vector<std::uint64_t> counts{};
+        std::vector<double> generationRates{};
+        std::vector<double> evaluationRates{};
+
+        // O GA imprime o progresso; fica fora da saída do teste
+        std::ostringstream discard{};
+        std::streambuf* const console{ std::cout.rdbuf(discard.rdbuf()) };
+
+        Timer window;
+        for(int run {0}; run < minimumRuns || window.elapsed() < measureSeconds; ++run)
+        {
+            Random::mt = Random::stream(p.seed, 0);
+            const std::uint64_t before{ evaluationCount() };
+
+            Timer timer;
+            const RunResult result{ runOptimizer(p, 1, false) };
+            const double seconds{ std::max(timer.elapsed(), 1e-9) };
+
+            const std::uint64_t evaluations{ evaluationCount() - before };
+            bests.push_back(result.best.get_fitness());
+            counts.push_back(evaluations);
+
+            generationRates.push_back(result.generations / seconds);
+            evaluationRates.push_back(static_cast<double>(evaluations) / seconds);
+
+            // Elitismo: o melhor de uma geração nunca é pior que o da anterior
+            for(std::size_t g {1}; g < result.trace.size(); ++g)
+            {
+                if(result.trace[g].best > result.trace[g - 1].best)
+                {
+                    std::ostringstream message{};
+                    message << "best fitness got worse at generation " << result.trace[g].generation + 1 << ": "
+                            << result.trace[g - 1].best << " -> " << result.trace[g].best;
+                    measurement.failures.push_back(message.str());
+                    break;
+                }
+            }
+
+            if(!result.trace.empty() && result.best.get_fitness() > result.trace.back().best)
+                measurement.failures.push_back("returned solution is worse than the last generation's best");
+        }
+
+        std::cout.rdbuf(console);
+
+        measurement.runs                 = static_cast<int>(generationRates.size());
+        measurement.generationsPerSecond = quantile(generationRates, 0.5);
+        measurement.evaluationsPerSecond = quantile(evaluationRates, 0.5);
+        measurement.spread               = 1.0 - quantile(generationRates, 0.1) / measurement.generationsPerSecond;
+        measurement.bestFitness          = bests.front();
+        if(std::any_of(bests.begin(), bests.end(), [&bests](double b) { return b != bests.front(); }) ||
+           std::any_of(counts.begin(), counts.end(), [&counts](std::uint64_t c) { return c != counts.front(); }))
+            measurement.failures.push_back("runs with the same seed disagree (best fitness or evaluation count)");
+
+        return measurement;
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream file(path);
+        std::stringstream contents{};
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    /// @brief Number after `"key":` at or after `from`, within [from, to).
+    bool readNumber(const std::string& json, std::string_view key, std::size_t from, std::size_t to, double& value)
+    {
+        const std::size_t position{ json.find('"' + std::string{ key } + '"', from) };
+        if(position == std::string::npos || position >= to)
+            return false;
+
+        const std::size_t colon{ json.find(':', position) };
+        if(colon == std::string::npos || colon >= to)
+            return false;
+
+        value = std::strtod(json.c_str() + colon + 1, nullptr);
+        return true;
+    }
+
+    double readTolerance(const std::string& json)
+    {
+        if(const char* environment{ std::getenv("GAO_PERF_TOLERANCE") })
+            return std::strtod(environment, nullptr);
+
+        double tolerance{ defaultTolerance };
+        readNumber(json, "tolerance", 0, json.size(), tolerance);
+        return tolerance;
+    }
+
+    Baseline readBaseline(const std::string& json, const Scenario& scenario)
+    {
+        Baseline baseline{};
+
+        const std::size_t position{ json.find('"' + scenario.name() + '"') };
+        if(position == std::string::npos)
+            return baseline;
+
+        const std::size_t end{ json.find('}', position) };
+        baseline.found = readNumber(json, "generations_per_second", position, end, baseline.generationsPerSecond) &&
+                         readNumber(json, "evaluations_per_second", position, end, baseline.evaluationsPerSecond);
+        readNumber(json, "spread", position, end, baseline.spread);
+
+        return baseline;
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    std::vector<Scenario> allScenarios()
+    {
+        std::vector<Scenario> scenarios{};
+        for(std::size_t function {0}; function < functions.size(); ++function)
+            for(std::size_t selection {0}; selection < selections.size(); ++selection)
+                for(std::size_t points {0}; points < crossovers.size(); ++points)
+                    scenarios.push_back({ function, selection, points });
+
+        return scenarios;
+    }
+
+    /// @return true if the scenario passed
+    bool check(const Scenario& scenario, const std::string& json, double tolerance)
+    {
+        const Measurement measured{ measure(scenario) };
+        const Baseline baseline{ readBaseline(json, scenario) };
+        std::vector<std::string> failures{ measured.failures };
+
+        if(!baseline.found)
+            failures.push_back("no baseline stored; run with --update");
+        else
+        {
+            // Cenários ruidosos na medição da linha de base ganham uma faixa mais larga
+            const double floor{ 1.0 - std::min(std::max(tolerance, 2.0 * baseline.spread), 0.9) };
+            if(measured.generationsPerSecond < floor * baseline.generationsPerSecond)
+                failures.push_back("generations/s regressed below the tolerance band");
+            if(measured.evaluationsPerSecond < floor * baseline.evaluationsPerSecond)
+                failures.push_back("evaluations/s regressed below the tolerance band");
+        }
+
+        std::cout << std::left << std::setw(34) << scenario.name() << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(10) << measured.generationsPerSecond << " gen/s (baseline " << baseline.generationsPerSecond << ")"
+                  << std::setw(12) << measured.evaluationsPerSecond << " eval/s (baseline " << baseline.evaluationsPerSecond << ")"
+                  << std::defaultfloat << "  median of " << measured.runs << " runs, best " << measured.bestFitness << '\n';
+
+        for(const std::string& failure : failures)
+            std::cout << "\tFAIL: " << failure << '\n';
+
+        return failures.empty();
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    int update(const std::string& path, double tolerance)
+    {
+        std::ostringstream json{};
+        json << "{\n  \"tolerance\": " << tolerance << ",\n  \"scenarios\": {\n";
+
+        const std::vector<Scenario> scenarios{ allScenarios() };
+        bool passed{ true };
+        for(std::size_t i {0}; i < scenarios.size(); ++i)
+        {
+            const Measurement measured{ measure(scenarios[i]) };
+            for(const std::string& failure : measured.failures)
+            {
+                std::cout << scenarios[i].name() << ": FAIL: " << failure << '\n';
+                passed = false;
+            }
+
+            json << "    \"" << scenarios[i].name() << "\": { \"generations_per_second\": " << std::fixed << std::setprecision(1) << measured.generationsPerSecond
+                 << ", \"evaluations_per_second\": " << measured.evaluationsPerSecond
+                 << ", \"spread\": " << std::setprecision(3) << measured.spread << " }" << (i + 1 < scenarios.size() ? "," : "") << '\n';
+            std::cout << scenarios[i].name() << ": " << measured.generationsPerSecond << " gen/s, " << measured.evaluationsPerSecond << " eval/s\n";
+        }
+
+        json << "  }\n}\n";
+
+        if(!passed)
+        {
+            std::cerr << "Invariant failures: baseline not written\n";
+            return EXIT_FAILURE;
+        }
+
+        std::ofstream file(path);
+        file << json.str();
+        std::cout << "Baseline written to: " << path << '\n';
+
+        return EXIT_SUCCESS;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    if(argc < 3)
+    {
+        std::cerr << "Usage: gao_perf <baseline.json> (<function> <selection> <points> | --all | --update)\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::string path{ argv[1] };
+    const std::string mode{ argv[2] };
+    const std::string json{ readFile(path) };
+    const double tolerance{ readTolerance(json) };
+
+    if(mode == "--update")
+        return update(path, json.empty() ? defaultTolerance : tolerance);
+
+    if(json.empty())
+    {
+        std::cerr << "Unable to open baseline: " << path << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if(mode == "--all")
+    {
+        int failed{ 0 };
+        for(const Scenario& scenario : allScenarios())
+            failed += check(scenario, json, tolerance) ? 0 : 1;
+
+        std::cout << failed << " scenario(s) failed\n";
+        return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if(argc < 5)
+    {
+        std::cerr << "Usage: gao_perf <baseline.json> <function> <selection> <points>\n";
+        return EXIT_FAILURE;
+    }
+
+    Scenario scenario{};
+    if(!indexOf(functions, argv[2], scenario.function) || !indexOf(selections, argv[3], scenario.selection) || !indexOf(crossovers, argv[4], scenario.points))
+    {
+        std::cerr << "Unknown scenario: " << argv[2] << '/' << argv[3] << '/' << argv[4] << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return check(scenario, json, tolerance) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "breeding.h"
+#include "Chromosome.h"
+#include "FitnessCache.h"
+#include "gao_c.h"
+#include "migration.h"
+#include "genetic_operators.h"
+#include "Random.h"
+
+// Unit tests for invariants of the library that the end-to-end performance suite cannot see, registered
+// with ctest one case per test.
+//
+//   gao_unit <case>    runs one case
+//   gao_unit --all     runs every case
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+    struct Failures
+    {
+        std::vector<std::string> messages{};
+
+        void expect(bool condition, const std::string& message)
+        {
+            if(!condition)
+                messages.push_back(message);
+        }
+    };
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    /// Slices of parallelCreateNewGeneration tile [begin, end) and differ in size by at most one individual.
+    void sliceBalance(Failures& failures)
+    {
+        for(const int begin : { 0, 1, 4, 10 })
+            for(const int size : { 0, 1, 7, 63, 64, 100, 999, 1000, 12345 })
+                for(const int slices : { 1, 2, 3, 4, 7, 8, 16, 64, 200 })
+                {
+                    const int end{ begin + size };
+                    int smallest{ size };
+                    int largest{ 0 };
+
+                    failures.expect(threadSliceStart(begin, end, 0, slices) == begin && threadSliceStart(begin, end, slices, slices) == end,
+                                    "slices do not cover [" + std::to_string(begin) + ", " + std::to_string(end) + ")");
+
+                    for(int tid {0}; tid < slices; ++tid)
+                    {
+                        const int length{ threadSliceStart(begin, end, tid + 1, slices) - threadSliceStart(begin, end, tid, slices) };
+                        smallest = std::min(smallest, length);
+                        largest  = std::max(largest, length);
+                    }
+
+                    failures.expect(largest - smallest <= 1, std::to_string(size) + " individuals over " + std::to_string(slices) + " slices: sizes from " +
+                                                             std::to_string(smallest) + " to " + std::to_string(largest));
+                }
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    /// fps and ranking over a selection fitness rewritten by sharing or clearing (out of order, cleared rows at the maximum).
+    void nichedSelection(Failures& failures)
+    {
+        constexpr double cleared{ std::numeric_limits<double>::max() };
+        const std::vector<double> fitness{ -0.5, -2.0, cleared, -1.0, cleared, -0.25 };
+
+        Random::mt.seed(1);
+        std::vector<int> winners(20000);
+        ParentSelector select{};
+
+        select.prepare(fitness, SelectionMethod::fps, 3);
+        select.draw(winners);
+        failures.expect(std::none_of(winners.begin(), winners.end(), [&fitness](int w) { return fitness[w] == cleared; }),
+                        "fps drew an individual removed by clearing");
+
+        // Ranking pela fitness alterada: o índice 1 é o primeiro e os eliminados são os últimos
+        select.prepare(fitness, SelectionMethod::ranking, 3);
+        select.draw(winners);
+
+        std::vector<int> counts(fitness.size());
+        for(const int w : winners)
+            ++counts[w];
+
+        failures.expect(counts[1] > counts[3] && counts[3] > counts[0] && counts[0] > counts[5] && counts[5] > counts[2] && counts[5] > counts[4],
+                        "ranking does not follow the order of the selection fitness");
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    /// Large (vectorized) and small tournaments over a fitness column holding NaN: NaN loses to any number.
+    void tournamentNan(Failures& failures)
+    {
+        const double nan{ std::numeric_limits<double>::quiet_NaN() };
+        std::vector<double> fitness(200);
+        for(std::size_t i {0}; i < fitness.size(); ++i)
+            fitness[i] = i % 10 == 0 ? nan : static_cast<double>(i);
+
+        Random::mt.seed(2);
+        std::vector<int> winners(5000);
+
+        for(const int k : { 3, 16, 32, 64 })
+        {
+            tournamentSelection(fitness, k, winners);
+
+            const bool inRange{ std::all_of(winners.begin(), winners.end(), [&fitness](int w) { return w >= 0 && w < static_cast<int>(fitness.size()); }) };
+            failures.expect(inRange, "tournament of " + std::to_string(k) + " returned an index outside the population");
+
+            // Com k >= 16 a chance de todos os candidatos serem NaN é desprezível
+            if(inRange && k >= 16)
+                failures.expect(std::none_of(winners.begin(), winners.end(), [&fitness](int w) { return std::isnan(fitness[w]); }),
+                                "tournament of " + std::to_string(k) + " picked a NaN over a number");
+        }
+
+        // Só NaN: o torneio ainda termina dentro da fatia
+        std::fill(fitness.begin(), fitness.end(), nan);
+        tournamentSelection(fitness, 32, winners);
+        failures.expect(std::all_of(winners.begin(), winners.end(), [&fitness](int w) { return w >= 0 && w < static_cast<int>(fitness.size()); }),
+                        "all-NaN tournament returned an index outside the population");
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    /// Two genomes whose slot hashes collide: the check hash keeps either from reading the other's fitness.
+    void cacheCollision(Failures& failures)
+    {
+        FitnessCache cache{ 64, 1 };
+        const FitnessCache::Key first{ 42, 1 };
+        const FitnessCache::Key second{ 42, 2 };
+        double fitness{};
+
+        cache.insert(first, 1.0);
+        failures.expect(!cache.lookup(second, fitness), "colliding genome read the fitness of another genome");
+        failures.expect(cache.lookup(first, fitness) && fitness == 1.0, "stored genome missed after a colliding lookup");
+
+        // O genoma mais recente fica com a vaga
+        cache.insert(second, 2.0);
+        failures.expect(cache.lookup(second, fitness) && fitness == 2.0, "colliding genome did not replace the slot");
+        failures.expect(!cache.lookup(first, fitness), "replaced genome still hits");
+
+        const std::vector<double> genes{ 0.5, -1.25, 3.0 };
+        std::vector<double> other{ genes };
+        other[2] = std::nextafter(other[2], 4.0);
+
+        const FitnessCache::Key a{ FitnessCache::key(genes.data(), genes.size() * sizeof(double)) };
+        const FitnessCache::Key b{ FitnessCache::key(other.data(), other.size() * sizeof(double)) };
+        failures.expect(a.hash != b.hash && a.check != b.check, "one flipped bit left a hash unchanged");
+        failures.expect(a.hash != a.check, "slot and check hashes are the same function");
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    /// C interface: out-of-range enum fields are refused, and NaN fitness from the host does not break the ranking.
+    void cApi(Failures& failures)
+    {
+        const double lower[2]{ -1.0, -1.0 };
+        const double upper[2]{ 1.0, 1.0 };
+
+        gao_config config{};
+        gao_config_defaults(&config);
+        config.pop_size = 20;
+        config.crossover = 6;
+        failures.expect(gao_create(&config, lower, upper) == nullptr && *gao_last_error() != '\0', "crossover 6 was accepted");
+
+        config.crossover = 2;
+        config.boundary_handling = -1;
+        failures.expect(gao_create(&config, lower, upper) == nullptr, "boundary_handling -1 was accepted");
+
+        failures.expect(gao_create_from_file("/nonexistent/gao.txt") == nullptr && *gao_last_error() != '\0', "missing config file was accepted");
+
+        config.boundary_handling = 0;
+        gao_optimizer* optimizer{ gao_create(&config, lower, upper) };
+        failures.expect(optimizer != nullptr, std::string{ "valid config refused: " } + gao_last_error());
+        if(!optimizer)
+            return;
+
+        // Metade das avaliações falha (NaN); as demais são a soma dos quadrados
+        const double nan{ std::numeric_limits<double>::quiet_NaN() };
+        std::vector<double> fitness{};
+        for(int generation {0}; generation < 5; ++generation)
+        {
+            std::size_t count{};
+            const double* genomes{ gao_ask(optimizer, &count) };
+            fitness.resize(count);
+            for(std::size_t i {0}; i < count; ++i)
+                fitness[i] = i % 2 == 0 ? nan : genomes[2 * i] * genomes[2 * i] + genomes[2 * i + 1] * genomes[2 * i + 1];
+
+            failures.expect(gao_tell(optimizer, fitness.data(), count) == 0, std::string{ "tell with NaN failed: " } + gao_last_error());
+        }
+
+        failures.expect(std::isfinite(gao_best_fitness(optimizer)), "a failed evaluation ranked as the best individual");
+        gao_destroy(optimizer);
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    /// The tiled mutateFrom makes the same draws as copying, mutate() and checkBounds(), for every repair mode and
+    /// genomes both narrower and wider than one tile.
+    void mutateFromDraws(Failures& failures)
+    {
+        for(const BoundaryHandling mode : { BoundaryHandling::clamp, BoundaryHandling::reflect, BoundaryHandling::wrap, BoundaryHandling::reinit })
+            for(const int dimensions : { 10, 1024, 3000 })
+            {
+                const SearchBounds bounds{ std::vector<double>(dimensions, -1.0), std::vector<double>(dimensions, 1.0), mode };
+                const BasicChromosome<double> source{ std::vector<double>(dimensions, 0.9) };
+
+                Random::mt.seed(3);
+                BasicChromosome<double> tiled{};
+                const bool tiledChanged{ tiled.mutateFrom(source, 0.5, 0.5, bounds) };
+                const double tiledNext{ Random::rand() };
+
+                Random::mt.seed(3);
+                BasicChromosome<double> reference{ source };
+                const bool referenceChanged{ reference.mutate(0.5, 0.5) };
+                if(referenceChanged)
+                    reference.checkBounds(bounds);
+                const double referenceNext{ Random::rand() };
+
+                failures.expect(tiledChanged == referenceChanged && tiled == reference && tiledNext == referenceNext,
+                                "mutateFrom draws differ from mutate() + checkBounds() with mode " + std::to_string(static_cast<int>(mode)) +
+                                " and " + std::to_string(dimensions) + " dimensions");
+            }
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    /// Two C optimizers with the same seed make the same run, whatever else draws from the calling thread's engine.
+    void seededOptimizer(Failures& failures)
+    {
+        const double lower[3]{ -5.0, -5.0, -5.0 };
+        const double upper[3]{ 5.0, 5.0, 5.0 };
+
+        gao_config config{};
+        gao_config_defaults(&config);
+        config.dimensions = 3;
+        config.pop_size = 30;
+        config.seed = 7;
+
+        const auto run{ [&config, &lower, &upper](int noise) {
+            gao_optimizer* optimizer{ gao_create(&config, lower, upper) };
+            std::vector<double> fitness{};
+
+            for(int generation {0}; generation < 10; ++generation)
+            {
+                for(int i {0}; i < noise; ++i)
+                    Random::mt();
+
+                std::size_t count{};
+                const double* genomes{ gao_ask(optimizer, &count) };
+                fitness.assign(count, 0.0);
+                for(std::size_t i {0}; i < count * 3; ++i)
+                    fitness[i / 3] += genomes[i] * genomes[i];
+
+                gao_tell(optimizer, fitness.data(), count);
+            }
+
+            std::vector<double> best(gao_best_genes(optimizer), gao_best_genes(optimizer) + 3);
+            gao_destroy(optimizer);
+            return best;
+        } };
+
+        failures.expect(run(0) == run(13), "the same seed gave two different runs");
+
+        config.seed = 8;
+        const std::vector<double> other{ run(0) };
+        config.seed = 7;
+        failures.expect(other != run(0), "different seeds gave the same run");
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    /// Migrants are only accepted with the receiving island's genome length; malformed payloads are refused, not read.
+    void migrantDimensions(Failures& failures)
+    {
+        const Population<double> sender{ BasicChromosome<double>{ std::vector<double>{ 1.0, 2.0 } }, BasicChromosome<double>{ std::vector<double>{ 3.0, 4.0 } } };
+        const std::vector<std::byte> payload{ serializeMigrants(sender, 2) };
+
+        const auto refused{ [&failures](const std::vector<std::byte>& bytes, std::size_t dimensions, const std::string& what) {
+            try
+            {
+                deserializeMigrants<float>(bytes, dimensions);
+                failures.expect(false, what + " was accepted");
+            }
+            catch(const std::invalid_argument&) {}
+        } };
+
+        failures.expect(deserializeMigrants<float>(payload, 2).size() == 2, "migrants of the same dimension were refused");
+        refused(payload, 3, "2-dimensional migrants on a 3-dimensional island");
+        refused(std::vector<std::byte>(payload.begin(), payload.end() - 1), 2, "truncated payload");
+    }
+
+    // -------------------------------------------------------------------------------------------------------------------------------------
+
+    struct Case
+    {
+        std::string_view                name{};
+        std::function<void(Failures&)>  run{};
+    };
+
+    const std::vector<Case> cases{
+        { "slice_balance", sliceBalance },
+        { "niched_selection", nichedSelection },
+        { "tournament_nan", tournamentNan },
+        { "cache_collision", cacheCollision },
+        { "c_api", cApi },
+        { "mutate_from_draws", mutateFromDraws },
+        { "migrant_dimensions", migrantDimensions },
+        { "seeded_optimizer", seededOptimizer },
+    };
+
+    /// @return true if the case passed
+    bool run(const Case& unit)
+    {
+        Failures failures{};
+        unit.run(failures);
+
+        std::cout << unit.name << (failures.messages.empty() ? ": ok\n" : ": FAIL\n");
+        for(const std::string& message : failures.messages)
+            std::cout << "\t" << message << '\n';
+
+        return failures.messages.empty();
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: gao_unit (<case> | --all)\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::string_view mode{ argv[1] };
+
+    if(mode == "--all")
+    {
+        int failed{ 0 };
+        for(const Case& unit : cases)
+            failed += run(unit) ? 0 : 1;
+
+        return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const auto unit{ std::find_if(cases.begin(), cases.end(), [mode](const Case& c) { return c.name == mode; }) };
+    if(unit == cases.end())
+    {
+        std::cerr << "Unknown case: " << mode << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return run(*unit) ? EXIT_SUCCESS : EXIT_FAILURE;
+}